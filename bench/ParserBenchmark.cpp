@@ -0,0 +1,205 @@
+/*
+ * Scaling benchmark of the parser of the Oberon-0 compiler.
+ *
+ * Parses synthetically generated modules with a growing number of declarations and reports the time per
+ * declaration for every size. The modules mix constants, records, lists of variables and procedures with
+ * parameters and local variables, so that every check for duplicate identifiers of the parser is exercised.
+ * As long as these checks are linear in the number of declarations, the time per declaration stays flat
+ * from the smallest to the largest module, which has 200000 declarations by default.
+ *
+ * Every parsed module is also walked by a pass that counts its nodes, once with the statically dispatched
+ * visitor of the compiler and once with the same pass built on virtual visit functions as a baseline.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "FileTable.h"
+#include "Parser.h"
+#include "ast/Visitor.h"
+
+struct Result {
+    size_t declarations;
+    size_t bytes;
+    double seconds;
+    long nodes;
+    double visitSeconds, virtualSeconds;
+};
+
+/*
+ * The baseline of the visitor: the traversal is the same, but every visit function is virtual.
+ */
+class VirtualVisitor : public Visitor<VirtualVisitor> {
+public:
+    virtual ~VirtualVisitor() = default;
+    virtual void visitModule(const Module *node) { Visitor::visitModule(node); }
+    virtual void visitConstVariable(const ConstVariable *node) { Visitor::visitConstVariable(node); }
+    virtual void visitTypeVariable(const TypeVariable *node) { Visitor::visitTypeVariable(node); }
+    virtual void visitVarVariable(const VarVariable *node) { Visitor::visitVarVariable(node); }
+    virtual void visitField(const Variable *node) { Visitor::visitField(node); }
+    virtual void visitProcedureVariable(const ProcedureVariable *node) { Visitor::visitProcedureVariable(node); }
+    virtual void visitBasicType(const Type *node) { Visitor::visitBasicType(node); }
+    virtual void visitArrayType(const ArrayType *node) { Visitor::visitArrayType(node); }
+    virtual void visitRecordType(const RecordType *node) { Visitor::visitRecordType(node); }
+    virtual void visitAssignmentStatement(const AssignmentStatement *node) { Visitor::visitAssignmentStatement(node); }
+    virtual void visitProcedureCallStatement(const ProcedureCallStatement *node) { Visitor::visitProcedureCallStatement(node); }
+    virtual void visitIfStatement(const IfStatement *node) { Visitor::visitIfStatement(node); }
+    virtual void visitElseIf(const ElseIf *node) { Visitor::visitElseIf(node); }
+    virtual void visitElse(const Else *node) { Visitor::visitElse(node); }
+    virtual void visitWhileStatement(const WhileStatement *node) { Visitor::visitWhileStatement(node); }
+    virtual void visitArraySelector(const ArraySelector *node) { Visitor::visitArraySelector(node); }
+    virtual void visitRecordSelector(const RecordSelector *node) { Visitor::visitRecordSelector(node); }
+    virtual void visitReference(const Variable *node) { Visitor::visitReference(node); }
+    virtual void visitExpression(const Expression *expression) { Visitor::visitExpression(expression); }
+    virtual void visitExpressionNode(const ExpressionNode &node) { Visitor::visitExpressionNode(node); }
+};
+
+// counts the declarations, types, statements and expression nodes of a module
+template <typename Base>
+class Counter : public Base {
+public:
+    long nodes = 0;
+    void visitConstVariable(const ConstVariable *node) { nodes++; Base::visitConstVariable(node); }
+    void visitTypeVariable(const TypeVariable *node) { nodes++; Base::visitTypeVariable(node); }
+    void visitVarVariable(const VarVariable *node) { nodes++; Base::visitVarVariable(node); }
+    void visitField(const Variable *node) { nodes++; Base::visitField(node); }
+    void visitProcedureVariable(const ProcedureVariable *node) { nodes++; Base::visitProcedureVariable(node); }
+    void visitBasicType(const Type *node) { nodes++; Base::visitBasicType(node); }
+    void visitRecordType(const RecordType *node) { nodes++; Base::visitRecordType(node); }
+    void visitAssignmentStatement(const AssignmentStatement *node) { nodes++; Base::visitAssignmentStatement(node); }
+    void visitExpressionNode(const ExpressionNode &node) { nodes++; Base::visitExpressionNode(node); }
+};
+
+class StaticCounter : public Counter<Visitor<StaticCounter>> {
+};
+
+class VirtualCounter : public Counter<VirtualVisitor> {
+};
+
+template <typename Pass>
+static double walk(const Module *module, const int repeat, long &nodes) {
+    double best = 0;
+    for (int i = 0; i < repeat; i++) {
+        Pass pass;
+        auto start = std::chrono::steady_clock::now();
+        pass.visit(module);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        nodes = pass.nodes;
+        if (i == 0 || elapsed.count() < best) {
+            best = elapsed.count();
+        }
+    }
+    return best;
+}
+
+static std::string generate(const size_t declarations) {
+    std::stringstream module;
+    module << "MODULE Bench;\n";
+    size_t count = 0;
+    for (size_t i = 0; count < declarations; i++) {
+        switch (i % 4) {
+            case 0:
+                module << "CONST c" << i << " = " << i << ";\n";
+                count++;
+                break;
+            case 1:
+                module << "TYPE t" << i << " = RECORD f0, f1: INTEGER; f2: INTEGER END;\n";
+                count++;
+                break;
+            case 2:
+                module << "VAR ";
+                for (int j = 0; j < 8; j++) {
+                    module << (j == 0 ? "" : ", ") << "v" << i << "x" << j;
+                }
+                module << ": INTEGER;\n";
+                count += 8;
+                break;
+            default:
+                module << "PROCEDURE p" << i << "(a, b: INTEGER; VAR c: INTEGER);\n"
+                       << "VAR x, y: INTEGER;\n"
+                       << "BEGIN x := a; c := x + b END p" << i << ";\n";
+                count++;
+                break;
+        }
+    }
+    module << "END Bench.\n";
+    return module.str();
+}
+
+static Result run(const size_t declarations, const int repeat) {
+    const std::string source = generate(declarations);
+    // the generated module is valid, so the output of the logger is discarded
+    std::ostream discard(nullptr);
+    Logger logger(LogLevel::ERROR, &discard, &discard);
+    Result result = { declarations, source.size(), 0, 0, 0, 0 };
+    for (int i = 0; i < repeat; i++) {
+        // every run is a compilation of its own, so the files and identifiers of the previous one are dropped
+        FileTable::instance().clear();
+        IdentTable::instance().clear();
+        Scanner scanner("Bench.Mod", source.data(), source.size(), &logger);
+        Parser parser(&scanner, &logger);
+        auto start = std::chrono::steady_clock::now();
+        const auto &module = parser.parse();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (module == nullptr) {
+            std::cerr << "Generated module with " << declarations << " declarations failed to parse." << std::endl;
+            exit(1);
+        }
+        if (i == 0 || elapsed.count() < result.seconds) {
+            result.seconds = elapsed.count();
+        }
+        if (i == 0) {
+            // the walks are much shorter than parsing, so they are repeated more often
+            long virtualNodes = 0;
+            result.visitSeconds = walk<StaticCounter>(module.get(), repeat * 10, result.nodes);
+            result.virtualSeconds = walk<VirtualCounter>(module.get(), repeat * 10, virtualNodes);
+            if (virtualNodes != result.nodes) {
+                std::cerr << "Visitors disagree on the number of nodes: " << result.nodes << " and " << virtualNodes
+                          << "." << std::endl;
+                exit(1);
+            }
+        }
+    }
+    return result;
+}
+
+static int usage() {
+    std::cout << "Usage: oberon0c-parser-bench [--repeat <n>] [<declarations>...]" << std::endl;
+    return 1;
+}
+
+int main(const int argc, const char *argv[]) {
+    int repeat = 3;
+    std::vector<size_t> sizes;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--repeat" && i + 1 < argc) {
+            repeat = std::max(1, atoi(argv[++i]));
+        } else if (!arg.empty() && arg[0] != '-' && atol(arg.c_str()) > 0) {
+            sizes.push_back((size_t) atol(arg.c_str()));
+        } else {
+            return usage();
+        }
+    }
+    if (sizes.empty()) {
+        sizes = { 25000, 50000, 100000, 200000 };
+    }
+    std::cout << std::left << std::setw(14) << "declarations" << std::right << std::setw(12) << "bytes"
+              << std::setw(12) << "ms" << std::setw(16) << "ns/declaration" << std::setw(10) << "nodes"
+              << std::setw(12) << "visit ms" << std::setw(14) << "virtual ms" << std::endl;
+    for (auto size : sizes) {
+        Result result = run(size, repeat);
+        std::cout << std::left << std::setw(14) << result.declarations << std::right << std::setw(12)
+                  << result.bytes << std::fixed << std::setprecision(1) << std::setw(12) << result.seconds * 1e3
+                  << std::setw(16) << result.seconds * 1e9 / (double) result.declarations << std::setw(10)
+                  << result.nodes << std::setprecision(2) << std::setw(12) << result.visitSeconds * 1e3
+                  << std::setw(14) << result.virtualSeconds * 1e3 << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,420 @@
+/*
+ * Throughput benchmark of the scanner of the Oberon-0 compiler.
+ *
+ * Scans a corpus of modules, optionally including synthetically generated modules in the style of the
+ * modules in the test directory, and reports tokens per second, bytes per second, heap allocations per
+ * scan and the peak resident set size of the process. With `--engine both`, every input is scanned by
+ * the hand-written and the table-driven engine. Every configuration other than the sequential hand-written
+ * engine is checked to produce the same token stream as the latter. With `--edits <n>`, every input is
+ * also edited as if typed into an editor, and the time to re-scan after a keystroke is reported. With
+ * `--backend memory` or `--backend stream`, the inputs are scanned from a string in memory or read through
+ * an input stream in bounded blocks instead of being mapped, in which case the peak resident set size does
+ * not depend on the size of the input; the streaming backend is also checked on literals that are split by
+ * the end of its window. With `--token-cache <directory>`, the first scan of every input writes its tokens to
+ * the cache, and all further scans load them from there.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "FileTable.h"
+#include "Scanner.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+static std::atomic<unsigned long> allocations(0);
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    void *p = malloc(size == 0 ? 1 : size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    free(p);
+}
+
+enum class Backend { file, memory, stream };
+
+struct Result {
+    std::string name;
+    std::string engine;
+    unsigned int threads;
+    size_t bytes;
+    long tokens;
+    double seconds;
+    unsigned long allocations;
+};
+
+static long peakRssKiB() {
+#if defined(__unix__) || defined(__APPLE__)
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return -1;
+#endif
+}
+
+static std::string tempDirectory() {
+    const char *dir = getenv("TMPDIR");
+    return (dir != nullptr && *dir != '\0') ? dir : "/tmp";
+}
+
+/*
+ * Writes a syntactically valid module of roughly the requested size, with the mix of comments,
+ * declarations, procedures and statements found in the modules of the test directory.
+ */
+static std::string generate(const size_t megabytes) {
+    std::string filename = tempDirectory() + "/oberon0c-bench-" + std::to_string(megabytes) + "MB.Mod";
+    std::ofstream out(filename);
+    const size_t target = megabytes * 1024 * 1024;
+    unsigned int seed = 42;
+    auto random = [&seed](unsigned int bound) {
+        seed = seed * 1103515245u + 12345u;
+        return (seed >> 16) % bound;
+    };
+    std::ostringstream ss;
+    ss << "(* Synthetic module for the scanner benchmark.\n   (* Comments may be nested. *) *)\n";
+    ss << "MODULE Bench;\n\n";
+    size_t written = 0;
+    size_t block = 0;
+    while (written + (size_t) ss.tellp() < target) {
+        ss << "(* Block " << block << " of constants, types and variables. *)\n";
+        ss << "CONST\n";
+        for (int i = 0; i < 32; i++) {
+            if (random(4) == 0) {
+                ss << "    K" << block << "x" << i << " = 0" << std::hex << std::uppercase << random(65536)
+                   << std::dec << "H;\n";
+            } else {
+                ss << "    K" << block << "x" << i << " = " << random(100000) << " * 2 + " << random(10) << ";\n";
+            }
+        }
+        ss << "TYPE Point" << block << " = RECORD x, y: INTEGER END;\n";
+        ss << "VAR a" << block << ": ARRAY " << (random(100) + 1) << " OF INTEGER;\n";
+        ss << "    p" << block << ": Point" << block << ";\n\n";
+        ss << "(* Sorts the array of block " << block << ". *)\n";
+        ss << "PROCEDURE Sort" << block << "(VAR n: INTEGER; flag: BOOLEAN);\n";
+        ss << "VAR i, j, t: INTEGER;\nBEGIN\n";
+        ss << "    i := n;\n";
+        ss << "    WHILE i > 1 DO\n";
+        ss << "        j := i - 1;\n";
+        ss << "        WHILE j >= 0 DO\n";
+        ss << "            IF (a" << block << "[i] > a" << block << "[j]) & ~flag OR (i # j) THEN\n";
+        ss << "                t := a" << block << "[i]; a" << block << "[i] := a" << block << "[j]; a"
+           << block << "[j] := t\n";
+        ss << "            ELSIF i <= j THEN p" << block << ".x := i DIV 2 ELSE p" << block
+           << ".y := j MOD 3 END;\n";
+        ss << "            j := j - 1\n";
+        ss << "        END;\n";
+        ss << "        i := i - 1 (* ; s := \"Hello \\\"World\\\"!\\n\" *)\n";
+        ss << "    END\n";
+        ss << "END Sort" << block << ";\n\n";
+        block++;
+        if (ss.tellp() > (1 << 20)) {
+            written += (size_t) ss.tellp();
+            out << ss.str();
+            ss.str("");
+        }
+    }
+    ss << "BEGIN\n    Sort0(a0[0], TRUE)\nEND Bench.\n";
+    out << ss.str();
+    return filename;
+}
+
+/*
+ * Writes a module in which a hexadecimal literal ends near the end of the first window of a streamed source,
+ * which holds two blocks, so that reading the 'H' of the literal refills the window and moves the digits that
+ * were read before it. The shift is the offset of the 'H' from the last character of the window.
+ */
+static std::string generateBoundary(const int shift) {
+    std::string filename = tempDirectory() + "/oberon0c-bench-boundary" + std::to_string(shift + 3) + ".Mod";
+    std::ofstream out(filename);
+    const std::string literal = "0FFFFFFFH";
+    const std::string head = "MODULE Boundary;\nCONST\n  K = ";
+    const size_t end = (size_t) ((long) (2 * SourceBuffer::BLOCK_SIZE) - 1 + shift);
+    out << head << std::string(end - head.size() - literal.size() + 1, ' ') << literal << " ;\nEND Boundary.\n";
+    return filename;
+}
+
+static const char* engineName(const ScanEngine engine) {
+    return engine == ScanEngine::table ? "table" : "direct";
+}
+
+/*
+ * Holds the input of a scanner that does not read the file itself, i.e., the text for the in-memory backend
+ * and the file stream for the streaming backend.
+ */
+struct Input {
+    std::string text;
+    std::ifstream stream;
+};
+
+static std::unique_ptr<Scanner> open(const std::string &filename, const Backend backend, Input &input,
+                                     const Logger *logger) {
+    switch (backend) {
+        case Backend::memory:
+            return std::make_unique<Scanner>(filename, input.text.data(), input.text.size(), logger);
+        case Backend::stream:
+            input.stream.open(filename, std::ios::in | std::ios::binary);
+            return std::make_unique<Scanner>(filename, input.stream, logger);
+        default:
+            return std::make_unique<Scanner>(filename, logger);
+    }
+}
+
+static void load(const std::string &filename, const Backend backend, Input &input) {
+    if (backend == Backend::memory) {
+        std::ifstream file(filename, std::ios::in | std::ios::binary);
+        input.text.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+}
+
+static Result run(const std::string &filename, const ScanEngine engine, const unsigned int threads,
+                  const Backend backend, const std::string &cacheDir, const int repeat) {
+    Logger logger;
+    Result result { filename, engineName(engine), threads, 0, 0, 0.0, 0 };
+    Input input;
+    load(filename, backend, input);
+    for (int i = 0; i < repeat; i++) {
+        // every run is a compilation of its own, so the files and identifiers of the previous one are dropped
+        FileTable::instance().clear();
+        IdentTable::instance().clear();
+        input.stream.close();
+        const unsigned long before = allocations.load();
+        const auto start = std::chrono::steady_clock::now();
+        auto scanner = open(filename, backend, input, &logger);
+        scanner->setEngine(engine);
+        scanner->setThreads(threads);
+        scanner->setCacheDirectory(cacheDir);
+        long tokens = 0;
+        size_t bytes = 0;
+        while (true) {
+            const Token token = scanner->nextToken();
+            if (token.getType() == TokenType::eof) {
+                bytes = token.getOffset();
+                break;
+            }
+            tokens++;
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (i == 0 || seconds < result.seconds) {
+            result.seconds = seconds;
+        }
+        result.tokens = tokens;
+        result.bytes = bytes;
+        result.allocations = allocations.load() - before;
+    }
+    return result;
+}
+
+/*
+ * Scans the file sequentially with the hand-written engine and with the given configuration, and reports the
+ * first token on which the two streams differ.
+ */
+static bool compare(const std::string &filename, const ScanEngine engine, const unsigned int threads,
+                    const Backend backend, const std::string &cacheDir) {
+    Logger logger;
+    Input input;
+    load(filename, backend, input);
+    Scanner reference(filename, &logger);
+    auto scanner = open(filename, backend, input, &logger);
+    scanner->setEngine(engine);
+    scanner->setThreads(threads);
+    scanner->setCacheDirectory(cacheDir);
+    long index = 0;
+    while (true) {
+        const Token expected = reference.nextToken();
+        const Token actual = scanner->nextToken();
+        if (expected.getType() != actual.getType() || expected.getOffset() != actual.getOffset() ||
+            expected.getLength() != actual.getLength() || expected.getValue() != actual.getValue()) {
+            std::cerr << filename << ": " << engineName(engine) << " engine with " << threads
+                      << " thread(s) differs at token " << index << " (offset "
+                      << expected.getOffset() << ")" << std::endl;
+            return false;
+        }
+        if (expected.getType() == TokenType::eof) {
+            return true;
+        }
+        index++;
+    }
+}
+
+/*
+ * Types a character at random positions of the file and deletes it again, re-scanning after each
+ * keystroke, and checks that the token stream is the same as before at the end.
+ */
+static bool edit(const std::string &filename, const ScanEngine engine, const int edits) {
+    Logger logger;
+    Scanner scanner(filename, &logger);
+    scanner.setEngine(engine);
+    const std::vector<Token> expected = scanner.getTokens();
+    const unsigned int size = expected.back().getOffset();
+    unsigned int seed = 42;
+    size_t rescanned = 0;
+    std::vector<double> times;
+    for (int i = 0; i < edits; i++) {
+        seed = seed * 1103515245u + 12345u;
+        const unsigned int offset = (seed >> 8) % (size + 1);
+        for (int j = 0; j < 2; j++) {
+            const auto start = std::chrono::steady_clock::now();
+            rescanned += (j == 0) ? scanner.edit({ offset, 0, "x" }).inserted : scanner.edit({ offset, 1, "" }).inserted;
+            times.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        }
+    }
+    double total = 0.0;
+    for (auto time : times) {
+        total += time;
+    }
+    std::sort(times.begin(), times.end());
+    std::cout << "  " << engineName(engine) << ": " << times.size() << " edits, " << std::fixed
+              << std::setprecision(1) << total / times.size() * 1e6 << " us mean, "
+              << times[times.size() / 2] * 1e6 << " us median, " << (double) rescanned / times.size()
+              << " re-scanned tokens per edit" << std::endl;
+    const std::vector<Token> &actual = scanner.getTokens();
+    for (size_t i = 0; i < expected.size(); i++) {
+        if (i >= actual.size() || expected[i].getType() != actual[i].getType() ||
+            expected[i].getOffset() != actual[i].getOffset() || expected[i].getLength() != actual[i].getLength() ||
+            expected[i].getValue() != actual[i].getValue()) {
+            std::cerr << filename << ": re-scanned tokens differ at token " << i << std::endl;
+            return false;
+        }
+    }
+    return expected.size() == actual.size();
+}
+
+static int usage() {
+    std::cout << "Usage: oberon0c-bench [--repeat <n>] [--engine <direct|table|both>] [--threads <n>] [--backend <file|memory|stream>] [--token-cache <directory>] [--edits <n>] [--generate <megabytes>]... [<filename>...]" << std::endl;
+    return 1;
+}
+
+int main(const int argc, const char *argv[]) {
+    int repeat = 5;
+    std::vector<ScanEngine> engines = { ScanEngine::direct };
+    unsigned int threads = 1;
+    Backend backend = Backend::file;
+    std::string cacheDir;
+    int edits = 0;
+    std::vector<std::string> files;
+    std::vector<std::string> generated;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--repeat" && i + 1 < argc) {
+            repeat = std::max(1, atoi(argv[++i]));
+        } else if (arg == "--engine" && i + 1 < argc) {
+            std::string name = argv[++i];
+            if (name == "direct") {
+                engines = { ScanEngine::direct };
+            } else if (name == "table") {
+                engines = { ScanEngine::table };
+            } else if (name == "both") {
+                engines = { ScanEngine::direct, ScanEngine::table };
+            } else {
+                return usage();
+            }
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = (unsigned int) std::max(1, atoi(argv[++i]));
+        } else if (arg == "--backend" && i + 1 < argc) {
+            std::string name = argv[++i];
+            if (name == "file") {
+                backend = Backend::file;
+            } else if (name == "memory") {
+                backend = Backend::memory;
+            } else if (name == "stream") {
+                backend = Backend::stream;
+            } else {
+                return usage();
+            }
+        } else if (arg == "--token-cache" && i + 1 < argc) {
+            cacheDir = argv[++i];
+        } else if (arg == "--edits" && i + 1 < argc) {
+            edits = std::max(0, atoi(argv[++i]));
+        } else if (arg == "--generate" && i + 1 < argc) {
+            generated.push_back(generate((size_t) std::max(1, atoi(argv[++i]))));
+            files.push_back(generated.back());
+        } else if (!arg.empty() && arg[0] == '-') {
+            return usage();
+        } else {
+            files.push_back(arg);
+        }
+    }
+    if (files.empty()) {
+        generated.push_back(generate(16));
+        files.push_back(generated.back());
+    }
+    std::cout << std::left << std::setw(40) << "input" << std::setw(8) << "engine" << std::right
+              << std::setw(8) << "threads" << std::setw(12) << "bytes" << std::setw(10) << "tokens" << std::setw(10) << "ms"
+              << std::setw(10) << "Mtok/s" << std::setw(10) << "MB/s" << std::setw(8) << "allocs" << std::endl;
+    int status = 0;
+    for (auto &file : files) {
+        for (auto engine : engines) {
+            const Result result = run(file, engine, threads, backend, cacheDir, repeat);
+            std::string name = result.name;
+            if (name.size() > 39) {
+                name = "..." + name.substr(name.size() - 36);
+            }
+            std::cout << std::left << std::setw(40) << name << std::setw(8) << result.engine << std::right
+                      << std::setw(8) << result.threads << std::fixed << std::setw(12) << result.bytes
+                      << std::setw(10) << result.tokens
+                      << std::setw(10) << std::setprecision(2) << result.seconds * 1e3
+                      << std::setw(10) << std::setprecision(1) << result.tokens / result.seconds / 1e6
+                      << std::setw(10) << std::setprecision(1) << result.bytes / result.seconds / (1024 * 1024)
+                      << std::setw(8) << result.allocations << std::endl;
+            // the check runs after the measurement, as the reference scan maps the whole file
+            if ((engine != ScanEngine::direct || threads > 1 || backend != Backend::file || !cacheDir.empty()) &&
+                !compare(file, engine, threads, backend, cacheDir)) {
+                status = 2;
+            }
+        }
+    }
+    if (backend == Backend::stream) {
+        // literals that are split by the end of the window are rare in generated modules, so they are checked apart
+        for (int shift = -3; shift <= 1; shift++) {
+            generated.push_back(generateBoundary(shift));
+            for (auto engine : engines) {
+                if (!compare(generated.back(), engine, threads, backend, cacheDir)) {
+                    status = 2;
+                }
+            }
+        }
+    }
+    if (edits > 0) {
+        for (auto &file : files) {
+            std::cout << file << std::endl;
+            for (auto engine : engines) {
+                if (!edit(file, engine, edits)) {
+                    status = 2;
+                }
+            }
+        }
+    }
+    std::cout << "peak RSS: " << peakRssKiB() << " KiB" << std::endl;
+    for (auto &file : generated) {
+        std::remove(file.c_str());
+    }
+    return status;
+}
@@ -4,21 +4,124 @@
  * Created by Michael Grossniklaus on 12/14/17.
  */
 
+#include <fstream>
 #include <iostream>
 #include "scanner/Scanner.h"
 #include "parser/Parser.h"
+#include "util/TimeReport.h"
+#include "util/Trace.h"
+
+static int usage() {
+    std::cout << "Usage: oberon0c [--lex-only] [--engine <direct|table>] [--threads <n>] [--token-cache <directory>] [--async-log] [--diagnostics <file>] [--time-report] [--trace <file>] <filename>|-" << std::endl;
+    return 1;
+}
 
 int main(const int argc, const char *argv[]) {
-    if (argc != 2) {
-        std::cout << "Usage: oberon0c <filename>" << std::endl;
-        return 1;
+    bool lexOnly = false;
+    ScanEngine engine = ScanEngine::direct;
+    int threads = 1;
+    std::string cacheDir;
+    bool asyncLog = false;
+    std::string diagnosticsFile;
+    bool timeReport = false;
+    std::string traceFile;
+    std::string filename;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--lex-only") {
+            lexOnly = true;
+        } else if (arg == "--engine" && i + 1 < argc) {
+            std::string name = argv[++i];
+            if (name == "direct") {
+                engine = ScanEngine::direct;
+            } else if (name == "table") {
+                engine = ScanEngine::table;
+            } else {
+                return usage();
+            }
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+            if (threads < 1) {
+                return usage();
+            }
+        } else if (arg == "--token-cache" && i + 1 < argc) {
+            cacheDir = argv[++i];
+        } else if (arg == "--async-log") {
+            asyncLog = true;
+        } else if (arg == "--diagnostics" && i + 1 < argc) {
+            diagnosticsFile = argv[++i];
+        } else if (arg == "--time-report") {
+            timeReport = true;
+        } else if (arg == "--trace" && i + 1 < argc) {
+            traceFile = argv[++i];
+        } else if (arg == "-" && filename.empty()) {
+            // the source is read from the standard input, which can be a pipe
+            filename = arg;
+        } else if (arg.empty() || arg[0] == '-' || !filename.empty()) {
+            return usage();
+        } else {
+            filename = arg;
+        }
+    }
+    if (filename.empty()) {
+        return usage();
     }
-    std::string filename = argv[1];
+    // declared before the logger, which writes the diagnostics to it when it is destroyed or the program exits
+    std::unique_ptr<std::ofstream> diagnostics;
     auto logger = std::make_unique<Logger>();
     logger->setLevel(LogLevel::DEBUG);
-    auto scanner = std::make_unique<Scanner>(filename, logger.get());
+    logger->setAsync(asyncLog);
+    if (!diagnosticsFile.empty()) {
+        diagnostics = std::make_unique<std::ofstream>(diagnosticsFile, std::ios::out | std::ios::trunc);
+        if (!diagnostics->is_open()) {
+            logger->error(diagnosticsFile, "Cannot open diagnostics file.");
+            return 1;
+        }
+        logger->setDiagnostics(diagnostics.get());
+    }
+    if (timeReport && !TimeReport::isAvailable()) {
+        logger->error(filename, "Time report is not available, as the compiler was built without OBERON0C_TIME_REPORT.");
+    }
+    TimeReport::setEnabled(timeReport && TimeReport::isAvailable());
+    std::ofstream trace;
+    if (!traceFile.empty()) {
+        if (!Trace::isAvailable()) {
+            logger->error(filename, "Trace is not available, as the compiler was built without OBERON0C_TRACE.");
+        } else {
+            trace.open(traceFile, std::ios::out | std::ios::trunc);
+            if (!trace.is_open()) {
+                logger->error(traceFile, "Cannot open trace file.");
+                return 1;
+            }
+            Trace::setEnabled(true);
+        }
+    }
+    std::unique_ptr<Scanner> scanner;
+    if (filename == "-") {
+        filename = "<stdin>";
+        scanner = std::make_unique<Scanner>(filename, std::cin, logger.get());
+    } else {
+        scanner = std::make_unique<Scanner>(filename, logger.get());
+    }
+    scanner->setEngine(engine);
+    scanner->setThreads((unsigned int) threads);
+    scanner->setCacheDirectory(cacheDir);
+    if (lexOnly) {
+        long tokens = 0;
+        while (scanner->nextToken().getType() != TokenType::eof) {
+            tokens++;
+        }
+        logger->info(filename.c_str(), "Scanning complete, ", tokens, " tokens.");
+        logger->flush();
+        TimeReport::write(std::cerr);
+        Trace::write(trace);
+        exit(0);
+    }
     auto parser = std::make_unique<Parser>(scanner.get(), logger.get());
 	parser->parse();
     logger->info(filename, "Parsing complete.");
+    logger->flush();
+    TimeReport::write(std::cerr);
+    Trace::write(trace);
     exit(0);
-}
\ No newline at end of file
+}
@@ -6,7 +6,7 @@
  
 class ArrayType : public Type {
 public:
-	explicit ArrayType(std::shared_ptr<const Expression> _expression, std::shared_ptr<const Type> _type);
-	std::shared_ptr<const Expression> expression;
-	std::shared_ptr<const Type> type;
+	explicit ArrayType(const Expression* _expression, const Type* _type);
+	const Expression* expression;
+	const Type* type;
 };
\ No newline at end of file
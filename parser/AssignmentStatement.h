@@ -9,7 +9,8 @@
 
 class AssignmentStatement : public Statement {
 public:
-	explicit AssignmentStatement(std::shared_ptr<const Expression> _expression);
-	std::shared_ptr<const Variable> variable;
-	std::shared_ptr<const Expression> expression;
+	explicit AssignmentStatement(const Variable* _variable, const Selector* _selector, const Expression* _expression);
+	const Variable* variable;
+	const Selector* selector;
+	const Expression* expression;
 };
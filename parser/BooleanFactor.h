@@ -1,9 +0,0 @@
-#pragma once
-
-#include "Factor.h"
-
-class BooleanFactor : public Factor {
-public:
-	explicit BooleanFactor(const bool _value);
-	const bool value;
-};
\ No newline at end of file
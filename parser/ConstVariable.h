@@ -5,6 +5,6 @@
 
 class ConstVariable : public Variable {
 public:
-	explicit ConstVariable(std::string _identifier, std::shared_ptr<const Expression> _expression);
-	std::shared_ptr<const Expression> expression;
+	explicit ConstVariable(Ident _identifier, const Expression* _expression);
+	const Expression* expression;
 };
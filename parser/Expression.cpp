@@ -1,18 +1,69 @@
 #include "Expression.h"
-#include "SimpleExpression.h"
-#include "SimpleExpressionElement.h"
-#include "Term.h"
-#include "TermElement.h"
+#include "Variable.h"
+#include "Scanner.h"
 
-Expression::Expression(std::shared_ptr<const SimpleExpression> _lhs) : lhs(_lhs), op(TokenType::null), type(_lhs.get()->type) { }
+Expression::Expression(PrimitiveType _type, uint32_t _begin, uint32_t _end) : type(_type), begin(_begin), end(_end) { }
 
-Expression::Expression(std::shared_ptr<const SimpleExpression> _lhs, TokenType _op, std::shared_ptr<const SimpleExpression> _rhs) : lhs(_lhs), op(_op), rhs(_rhs), type(PrimitiveType::Boolean) { }
+const uint32_t Expression::root() const { return end - 1; }
 
-SimpleExpression::SimpleExpression() { }
+Selection::Selection(const Variable *_variable, const Selector *_selector) : variable(_variable), selector(_selector) { }
 
-SimpleExpressionElement::SimpleExpressionElement(const TokenType _sign, std::shared_ptr<const Term> _term) : sign(_sign), term(_term) { }
+const uint32_t ExpressionNode::NONE;
 
-Term::Term() { }
+const ExpressionNode ExpressionNode::number(const int _value) {
+	ExpressionNode node;
+	node.op = ExpressionOp::number;
+	node.type = PrimitiveType::Number;
+	node.value = _value;
+	return node;
+}
 
-TermElement::TermElement(const TokenType _sign, std::shared_ptr<const Factor> _factor) : sign(_sign), factor(_factor) { }
+const ExpressionNode ExpressionNode::boolean(const bool _value) {
+	ExpressionNode node;
+	node.op = ExpressionOp::boolean;
+	node.type = PrimitiveType::Boolean;
+	node.value = _value ? 1 : 0;
+	return node;
+}
 
+const ExpressionNode ExpressionNode::string(const std::string *_text) {
+	ExpressionNode node;
+	node.op = ExpressionOp::string;
+	node.type = PrimitiveType::String;
+	node.text = _text;
+	return node;
+}
+
+const ExpressionNode ExpressionNode::reference(const Variable *_variable) {
+	ExpressionNode node;
+	node.op = ExpressionOp::variable;
+	node.type = _variable->primitiveType;
+	node.variable = _variable;
+	return node;
+}
+
+const ExpressionNode ExpressionNode::selected(const Selection *_selection) {
+	ExpressionNode node;
+	node.op = ExpressionOp::selection;
+	node.type = _selection->variable->primitiveType;
+	node.selection = _selection;
+	return node;
+}
+
+const ExpressionNode ExpressionNode::unary(ExpressionOp _op, PrimitiveType _type, uint32_t _operand) {
+	ExpressionNode node;
+	node.op = _op;
+	node.type = _type;
+	node.operands = { _operand, NONE };
+	return node;
+}
+
+const ExpressionNode ExpressionNode::binary(ExpressionOp _op, PrimitiveType _type, uint32_t _lhs, uint32_t _rhs) {
+	ExpressionNode node;
+	node.op = _op;
+	node.type = _type;
+	node.operands = { _lhs, _rhs };
+	return node;
+}
+
+const std::string ExpressionNode::decoded() const { return Scanner::decode(*text); }
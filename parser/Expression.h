@@ -1,17 +1,18 @@
 #pragma once
 
-#include <memory>
+#include <cstdint>
 
-#include "SimpleExpression.h"
-#include "Token.h"
+#include "ExpressionNode.h"
 #include "Type.h"
 
+/*
+ * An expression refers to its nodes in the flat expression encoding of the module: the nodes in [begin, end)
+ * are the expression in post-order, and the last of them is its root.
+ */
 class Expression {
 public:
-	Expression(std::shared_ptr<const SimpleExpression> _lhs);
-	Expression(std::shared_ptr<const SimpleExpression> _lhs, TokenType _op, std::shared_ptr<const SimpleExpression> _rhs);
-	std::shared_ptr<const SimpleExpression> lhs;
-	const TokenType op;
-	std::shared_ptr<const SimpleExpression> rhs;
+	explicit Expression(PrimitiveType _type, uint32_t _begin, uint32_t _end);
 	PrimitiveType type;
-};
\ No newline at end of file
+	uint32_t begin, end;
+	const uint32_t root() const;
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "Type.h"
+
+class Variable;
+class Selector;
+
+enum class ExpressionOp : unsigned char
+{
+	number,
+	string,
+	boolean,
+	variable,
+	selection,
+	negate,
+	logical_not,
+	add,
+	subtract,
+	logical_or,
+	multiply,
+	divide,
+	modulo,
+	logical_and,
+	equal,
+	not_equal,
+	less,
+	less_equal,
+	greater,
+	greater_equal
+};
+
+// a variable with a selector as it is used in an expression, e.g. a[i].x
+class Selection {
+public:
+	explicit Selection(const Variable *_variable, const Selector *_selector);
+	const Variable *variable;
+	const Selector *selector;
+};
+
+/*
+ * A node of the flat encoding of expressions. The nodes of all expressions of a module are kept in one array
+ * in post-order, so that the operands of an operator are stored before it and refer to its operands by index.
+ * The nodes of the index expressions of a selector come before the selection that uses them, but are not
+ * referenced by it, as the selector is kept with the selection.
+ */
+class ExpressionNode {
+public:
+	static const uint32_t NONE = UINT32_MAX;
+
+	struct Operands {
+		uint32_t lhs, rhs;
+	};
+
+	ExpressionOp op;
+	PrimitiveType type;
+	union {
+		// operators; rhs is NONE for unary operators
+		Operands operands;
+		// numbers and booleans
+		int value;
+		const Variable *variable;
+		const Selection *selection;
+		// string literals as they appear in the source, including quotes and escape sequences
+		const std::string *text;
+	};
+
+	static const ExpressionNode number(int _value);
+	static const ExpressionNode boolean(bool _value);
+	static const ExpressionNode string(const std::string *_text);
+	static const ExpressionNode reference(const Variable *_variable);
+	static const ExpressionNode selected(const Selection *_selection);
+	static const ExpressionNode unary(ExpressionOp _op, PrimitiveType _type, uint32_t _operand);
+	static const ExpressionNode binary(ExpressionOp _op, PrimitiveType _type, uint32_t _lhs, uint32_t _rhs);
+
+	const std::string decoded() const;
+};
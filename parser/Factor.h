@@ -1,10 +0,0 @@
-#pragma once
-
-#include <memory>
-#include "Type.h"
-
-class Factor {
-public:
-	Factor(PrimitiveType _type);
-	PrimitiveType type;
-};
\ No newline at end of file
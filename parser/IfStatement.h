@@ -6,26 +6,26 @@
 #include "Expression.h"
 #include "Statement.h"
 
-class Else {
+class Else : public Node {
 public:
 	explicit Else();
-	std::vector<std::shared_ptr<const Statement>> statements;
+	std::vector<const Statement*> statements;
 };
 
 
-class ElseIf {
+class ElseIf : public Node {
 public:
-	explicit ElseIf(std::shared_ptr<const Expression> _expression);
-	std::shared_ptr<const Expression> expression;
-	std::vector<std::shared_ptr<const Statement>> statements;
+	explicit ElseIf(const Expression* _expression);
+	const Expression* expression;
+	std::vector<const Statement*> statements;
 };
 
 class IfStatement :public Statement {
 public:
-	explicit IfStatement(std::shared_ptr<const Expression> _expression);
-	std::shared_ptr<const Expression> expression;
-	std::vector<std::shared_ptr<const Statement>> statements;
-	std::vector<std::shared_ptr<const ElseIf>> elseIfNodes;
-	std::shared_ptr<const Else> elseNode;
+	explicit IfStatement(const Expression* _expression);
+	const Expression* expression;
+	std::vector<const Statement*> statements;
+	std::vector<const ElseIf*> elseIfNodes;
+	const Else* elseNode;
 };
 
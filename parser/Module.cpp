@@ -1,3 +1,3 @@
 #include "Module.h"
 
-Module::Module(std::string _identifier) : identifier(_identifier), Node(NodeType::module){ }
+Module::Module(Ident _identifier) : identifier(_identifier), Node(NodeType::module){ }
@@ -1,18 +1,24 @@
 #pragma once
 
-#include <string>
 #include <memory>
 #include <vector>
 
 #include "Variable.h"
 #include "Statement.h"
+#include "ExpressionNode.h"
 #include "ast/Node.h"
+#include "Arena.h"
+#include "Ident.h"
 
 
 class Module: public Node {
 public:
-	explicit Module(std::string _identifier);
-	std::string identifier;
-	std::vector<std::shared_ptr<const Variable>> declarations;
-	std::vector<std::shared_ptr<const Statement>> statements;
+	explicit Module(Ident _identifier);
+	Ident identifier;
+	std::vector<const Variable*> declarations;
+	std::vector<const Statement*> statements;
+	// the nodes of all expressions of the module in post-order, see Expression
+	std::vector<ExpressionNode> expressionNodes;
+	// owns all nodes of the module, which are freed together with it
+	std::unique_ptr<Arena> arena;
 };
\ No newline at end of file
@@ -1,9 +0,0 @@
-#pragma once
-
-#include "Factor.h"
-
-class NotFactor: public Factor {
-public:
-	NotFactor(std::shared_ptr<const Factor> _factor);
-	std::shared_ptr<const Factor> factor;
-};
\ No newline at end of file
@@ -1,9 +0,0 @@
-#pragma once
-
-#include "Factor.h"
-
-class NumberFactor : public Factor {
-public:
-	NumberFactor(const int _value);
-	const int value;
-};
\ No newline at end of file
@@ -3,73 +3,79 @@
 //
 
 #include <iostream>
+#include <unordered_set>
 #include "Parser.h"
-#include "IdentToken.h"
-#include "StringToken.h"
-#include "NumberToken.h"
 
-#include "StringFactor.h"
-#include "NumberFactor.h"
-#include "BooleanFactor.h"
-#include "ExpressionFactor.h"
-#include "NotFactor.h"
-#include "VariableFactor.h"
 #include "RecordSelector.h"
+#include "TimeReport.h"
+#include "Trace.h"
 
 Parser::Parser(Scanner* scanner, Logger* logger) :
-	scanner_(scanner), logger_(logger) {
+	scanner_(scanner), logger_(logger),
+	integerIdent_(IdentTable::instance().intern("INTEGER")), longintIdent_(IdentTable::instance().intern("LONGINT")),
+	charIdent_(IdentTable::instance().intern("CHAR")), booleanIdent_(IdentTable::instance().intern("BOOLEAN")) {
 	symbolTable_ = SymbolTable();
 }
 
 Parser::~Parser() = default;
 
 const std::unique_ptr<const Module> Parser::parse() {
-	return module();
+	TIME_PHASE(parse);
+	TRACE_SCOPE("parse");
+	arena_ = std::make_unique<Arena>();
+	auto _module = module();
+	if (_module != nullptr)
+	{
+		_module->arena = std::move(arena_);
+		_module->expressionNodes = std::move(expressionNodes_);
+	}
+	return _module;
 }
 
-const std::string Parser::ident() {
-	if (token_->getType() == TokenType::const_ident) {
-		return static_cast<const IdentToken*>(token_.get())->getValue();
-	}
-	return "";
+const Ident Parser::ident() {
+	return token_.getIdent();
 }
 
-std::unique_ptr<const Module> Parser::module()
+std::unique_ptr<Module> Parser::module()
 {
 	// "MODULE" ident ";" declarations ["BEGIN" StatementSequence] "END" ident "."
+	TRACE_SCOPE("module");
 	token_ = scanner_->nextToken();
-	if (token_->getType() == TokenType::kw_module)
+	if (token_.getType() == TokenType::kw_module)
 	{
 		token_ = scanner_->nextToken();
-		std::string identifier = ident();
+		Ident identifier = ident();
 		if (!identifier.empty())
 		{
 			token_ = scanner_->nextToken();
-			if (token_->getType() == TokenType::semicolon)
+			if (token_.getType() == TokenType::semicolon)
 			{
 				token_ = scanner_->nextToken();
 				auto _module = std::make_unique<Module>(identifier);
-				logger_->info("", identifier + " module is created.");
-				for (auto& declaration : declarations()) {
-					bool isDeclarationOk = true;
-					for (auto moduleDeclaration : _module->declarations)
-						if (declaration->identifier == moduleDeclaration->identifier) {
-							logger_->error(token_->getPosition(), "- SEMANTIC ERROR; Identifier \"" + declaration->identifier + "\" has been used");
-							isDeclarationOk = false;
+				TRACE_DETAIL(identifier.getName());
+				logger_->info("", identifier.getName(), " module is created.");
+				const std::vector<const Variable*> moduleDeclarations = declarations();
+				{
+					TRACE_SCOPE("semantic check");
+					for (auto& declaration : moduleDeclarations) {
+						// the symbol table keeps the first declaration of a name in a scope, so any other is a duplicate
+						if (symbolTable_.lookup(declaration->identifier) != declaration) {
+							logger_->error(token_.getPosition(), "- SEMANTIC ERROR; Identifier \"", declaration->identifier.getName(), "\" has been used");
+						}
+						else
+						{
+							_module->declarations.emplace_back(declaration);
+							logger_->info("", "A ", declaration->identifier.getName(), " declaration is added to ", identifier.getName(), " Module.");
 						}
-					if (isDeclarationOk)
-					{
-						_module->declarations.emplace_back(declaration);
-						logger_->info("", "A " + declaration->identifier + " declaration is added to " + identifier + " Module.");
 					}
 				}
 
-				if (token_->getType() == TokenType::kw_begin)
+				if (token_.getType() == TokenType::kw_begin)
 				{
 					token_ = scanner_->nextToken();
 					_module->statements = statement_sequence();
 				}
-				if (token_->getType() == TokenType::kw_end)
+				if (token_.getType() == TokenType::kw_end)
 				{
 					token_ = scanner_->nextToken();
 					identifier = ident();
@@ -77,51 +83,52 @@ std::unique_ptr<const Module> Parser::module()
 					{
 						if (_module->identifier == identifier) {
 							token_ = scanner_->nextToken();
-							if (token_->getType() == TokenType::period)
+							if (token_.getType() == TokenType::period)
 							{
 								token_ = scanner_->nextToken();
 								return _module;
 							}
 							else
 							{
-								logger_->error(token_->getPosition(), "- SYNTAX ERROR; \".\" is missing.");
+								logger_->error(token_.getPosition(), "- SYNTAX ERROR; \".\" is missing.");
 							}
 						}
 						else {
-							logger_->error(token_->getPosition(), "- SEMANTIC ERROR; Module name is not same at the end.");
+							logger_->error(token_.getPosition(), "- SEMANTIC ERROR; Module name is not same at the end.");
 						}
 					}
 					else {
-						logger_->error(token_->getPosition(), "- SEMANTIC ERROR; Module name is missing.");
+						logger_->error(token_.getPosition(), "- SEMANTIC ERROR; Module name is missing.");
 					}
 				}
 				else {
-					logger_->error(token_->getPosition(), "- SYNTAX ERROR; \"END\" keyword is missing");
+					logger_->error(token_.getPosition(), "- SYNTAX ERROR; \"END\" keyword is missing");
 				}
 			}
 			else {
-				logger_->error(token_->getPosition(), "- SYNTAX ERROR; \";\" is missing");
+				logger_->error(token_.getPosition(), "- SYNTAX ERROR; \";\" is missing");
 			}
 		}
 		else {
-			logger_->error(token_->getPosition(), "- SYNTAX ERROR; MODULE idetifier is not valid.");
+			logger_->error(token_.getPosition(), "- SYNTAX ERROR; MODULE idetifier is not valid.");
 		}
 	}
 	else {
-		logger_->error(token_->getPosition(), "- SYNTAX ERROR; \"MODULE\" keyword is missing.");
+		logger_->error(token_.getPosition(), "- SYNTAX ERROR; \"MODULE\" keyword is missing.");
 	}
 	return nullptr;
 }
 
-const std::vector<std::shared_ptr<const Variable>> Parser::declarations() {
+const std::vector<const Variable*> Parser::declarations() {
+	TIME_PHASE(declarations);
 	// ["CONST" {ident "=" expression ";"}]
 	// ["TYPE" {ident "=" type ";"}]
 	// ["VAR" {IdentList ":" type ";"}]
 	// {ProcedureDeclaration ";"}.
-	std::vector<std::shared_ptr<const Variable>> declarationList;
-	while (token_->getType() == TokenType::kw_const || token_->getType() == TokenType::kw_type || token_->getType() == TokenType::kw_var || token_->getType() == TokenType::kw_procedure)
+	std::vector<const Variable*> declarationList;
+	while (token_.getType() == TokenType::kw_const || token_.getType() == TokenType::kw_type || token_.getType() == TokenType::kw_var || token_.getType() == TokenType::kw_procedure)
 	{
-		switch (token_->getType())
+		switch (token_.getType())
 		{
 		case TokenType::kw_const:
 			for (auto constantDeclaration : const_declarations()) {
@@ -152,6 +159,13 @@ const std::vector<std::shared_ptr<const Variable>> Parser::declarations() {
 			if (procedureDeclaration != nullptr)
 			{
 				declarationList.emplace_back(procedureDeclaration);
+				if (token_.getType() == TokenType::semicolon)
+				{
+					token_ = scanner_->nextToken();
+				}
+				else {
+					logger_->error(token_.getPosition(), "- SYNTAX ERROR; \";\" is missing");
+				}
 			}
 			break;
 		}
@@ -159,29 +173,29 @@ const std::vector<std::shared_ptr<const Variable>> Parser::declarations() {
 	return declarationList;
 }
 
-const std::vector<std::shared_ptr<const ConstVariable>> Parser::const_declarations() {
+const std::vector<const ConstVariable*> Parser::const_declarations() {
 	// "CONST" {ident "=" expression ";"}
-	std::vector<std::shared_ptr<const ConstVariable>> constantDeclarations;
+	std::vector<const ConstVariable*> constantDeclarations;
 	token_ = scanner_->nextToken();
-	std::string identifier = ident();
+	Ident identifier = ident();
 	if (!identifier.empty())
 	{
 		bool shouldRepeat = true;
 		while (shouldRepeat)
 		{
 			token_ = scanner_->nextToken();
-			if (token_->getType() == TokenType::op_eq)
+			if (token_.getType() == TokenType::op_eq)
 			{
 				token_ = scanner_->nextToken();
 				auto _expression = expression();
-				if (_expression.get() != nullptr)
+				if (_expression != nullptr)
 				{
-					if (token_->getType() == TokenType::semicolon)
+					if (token_.getType() == TokenType::semicolon)
 					{
-						auto constantVariable = std::make_shared<const ConstVariable>(identifier, _expression);
+						auto constantVariable = arena_->create<ConstVariable>(identifier, _expression);
 						constantDeclarations.emplace_back(constantVariable);
 						symbolTable_.insert(identifier, constantVariable);
-						logger_->info("CONST Declaration", "Name: " + identifier);
+						logger_->info("CONST Declaration", "Name: ", identifier.getName());
 						token_ = scanner_->nextToken();
 						identifier = ident();
 						if (identifier.empty())
@@ -190,49 +204,49 @@ const std::vector<std::shared_ptr<const ConstVariable>> Parser::const_declaratio
 						}
 					}
 					else {
-						logger_->error(token_->getPosition(), "- SYNTAX ERROR; \";\" is missing.");
+						logger_->error(token_.getPosition(), "- SYNTAX ERROR; \";\" is missing.");
 						shouldRepeat = false;
 					}
 				}
 				else {
-					logger_->error(token_->getPosition(), "- SEMANTIC ERROR; No valid expression.");
+					logger_->error(token_.getPosition(), "- SEMANTIC ERROR; No valid expression.");
 					shouldRepeat = false;
 				}
 			}
 			else {
-				logger_->error(token_->getPosition(), "- SYNTAX ERROR; \"=\" is missing.");
+				logger_->error(token_.getPosition(), "- SYNTAX ERROR; \"=\" is missing.");
 				shouldRepeat = false;
 			}
 		}
 	}
 	else {
-		logger_->error(token_->getPosition(), "- SEMANTIC ERROR; Const declaration name is not valid.");
+		logger_->error(token_.getPosition(), "- SEMANTIC ERROR; Const declaration name is not valid.");
 	}
 	return constantDeclarations;
 }
 
-const std::vector<std::shared_ptr<const TypeVariable>> Parser::type_declarations() {
+const std::vector<const TypeVariable*> Parser::type_declarations() {
 	// "TYPE" {ident "=" type ";"} -> repetition
-	std::vector<std::shared_ptr<const TypeVariable>> typeDeclarations;
+	std::vector<const TypeVariable*> typeDeclarations;
 	bool shouldProceed = true;
 	token_ = scanner_->nextToken();
-	std::string identifier = ident();
+	Ident identifier = ident();
 	if (!identifier.empty())
 	{
 		while (shouldProceed)
 		{
 			token_ = scanner_->nextToken();
-			if (token_->getType() == TokenType::op_eq)
+			if (token_.getType() == TokenType::op_eq)
 			{
 				token_ = scanner_->nextToken();
 				auto _type = type();
-				if (_type.get() != nullptr)
+				if (_type != nullptr)
 				{
-					if (token_->getType() == TokenType::semicolon)
+					if (token_.getType() == TokenType::semicolon)
 					{
-						auto typeDeclaration = std::make_shared<const TypeVariable>(identifier, _type);
+						auto typeDeclaration = arena_->create<TypeVariable>(identifier, _type);
 						typeDeclarations.emplace_back(typeDeclaration);
-						logger_->info("TYPE Declaration", "Name: " + identifier);
+						logger_->info("TYPE Declaration", "Name: ", identifier.getName());
 						symbolTable_.insert(identifier, typeDeclaration);
 						token_ = scanner_->nextToken();
 						identifier = ident();
@@ -243,188 +257,227 @@ const std::vector<std::shared_ptr<const TypeVariable>> Parser::type_declarations
 					}
 					else {
 						shouldProceed = false;
-						logger_->error(token_->getPosition(), "- SYNTAX ERROR; \";\ is missing.");
+						logger_->error(token_.getPosition(), "- SYNTAX ERROR; \";\ is missing.");
 					}
 				}
 				else {
-					logger_->error(token_->getPosition(), "- SEMANTIC ERROR; No valid type");
+					logger_->error(token_.getPosition(), "- SEMANTIC ERROR; No valid type");
 					shouldProceed = false;
 				}
 			}
 			else {
 				shouldProceed = false;
-				logger_->error(token_->getPosition(), "- SYNTAX ERROR; \"=\" is missing.");
+				logger_->error(token_.getPosition(), "- SYNTAX ERROR; \"=\" is missing.");
 			}
 		}
 	}
 	else {
-		logger_->error(token_->getPosition(), "- SYNTAX ERROR; Type declaration name is not valid.");
+		logger_->error(token_.getPosition(), "- SYNTAX ERROR; Type declaration name is not valid.");
 	}
 	return typeDeclarations;
 }
 
-const std::vector<std::shared_ptr<const VarVariable>> Parser::var_declarations() {
+const std::vector<const VarVariable*> Parser::var_declarations() {
 	// "VAR" {IdentList ":" type ";"}
-	std::vector<std::shared_ptr<const VarVariable>> varDeclarations;
+	std::vector<const VarVariable*> varDeclarations;
 	token_ = scanner_->nextToken();
 	bool shouldRepeat = true;
 	while (shouldRepeat)
 	{
-		std::vector<std::string> identifier_list = ident_list();
+		std::vector<Ident> identifier_list = ident_list();
 		if (identifier_list.size() != 0)
 		{
-			if (token_->getType() == TokenType::colon)
+			if (token_.getType() == TokenType::colon)
 			{
 				token_ = scanner_->nextToken();
 				auto _type = type();
 				if (_type != nullptr)
 				{
-					if (token_->getType() == TokenType::semicolon)
+					if (token_.getType() == TokenType::semicolon)
 					{
 						for (auto const& identifier : identifier_list) {
-							auto varVariable = std::make_shared<const VarVariable>(identifier, _type);
+							auto varVariable = arena_->create<VarVariable>(identifier, _type);
 							varDeclarations.emplace_back(varVariable);
-							logger_->info("Var Declaration", "Name: " + identifier);
+							logger_->info("Var Declaration", "Name: ", identifier.getName());
 							symbolTable_.insert(identifier, varVariable);
 						}
 						token_ = scanner_->nextToken();
 					}
 					else {
 						shouldRepeat = false;
-						logger_->error(token_->getPosition(), "- SYNTAX ERROR; \";\ is missing");
+						logger_->error(token_.getPosition(), "- SYNTAX ERROR; \";\ is missing");
 					}
 				}
 				else {
-					logger_->error(token_->getPosition(), "- SEMANTIC ERROR; No valid type");
+					logger_->error(token_.getPosition(), "- SEMANTIC ERROR; No valid type");
 					shouldRepeat = false;
 				}
 			}
 			else {
 				shouldRepeat = false;
-				logger_->error(token_->getPosition(), "- SYNTAX ERROR; \":\" is missing");
+				logger_->error(token_.getPosition(), "- SYNTAX ERROR; \":\" is missing");
 			}
 		}
 		else {
-			//logger_->error(token_->getPosition(), "- SEMANTIC ERROR; Identifier names are not valid or specified");
+			//logger_->error(token_.getPosition(), "- SEMANTIC ERROR; Identifier names are not valid or specified");
 			shouldRepeat = false;
 		}
 	}
 	return varDeclarations;
 }
 
-std::shared_ptr<const ProcedureVariable> Parser::procedure_declaration() {
+const ProcedureVariable* Parser::procedure_declaration() {
 	// ProcedureHeading ";" ProcedureBody
+	TRACE_SCOPE("procedure");
+	// the parameters and local declarations are only visible inside the procedure
+	symbolTable_.enterScope();
 	auto head = procedure_heading();
 	if (head != nullptr)
 	{
-		if (token_->getType() == TokenType::semicolon)
+		TRACE_DETAIL(head->identifier.getName());
+		if (token_.getType() == TokenType::semicolon)
 		{
 			token_ = scanner_->nextToken();
 			auto body = procedure_body(head->identifier);
 			if (body != nullptr)
 			{
-				auto procedure = std::make_shared<ProcedureVariable>(head->identifier);
+				auto procedure = arena_->create<ProcedureVariable>(head->identifier);
 				procedure->parameters = head->parameters;
 				procedure->declarations = body->declarations;
 				procedure->statements = body->statements;
+				symbolTable_.exitScope();
 				symbolTable_.insert(head->identifier, procedure);
-				logger_->info("Procedure Declaration", "Name: " + head->identifier);
+				logger_->info("Procedure Declaration", "Name: ", head->identifier.getName());
 				return procedure;
 			}
 			else {
-				logger_->error(token_->getPosition(), "- SYNTAX ERROR; No valid procedure body");
+				logger_->error(token_.getPosition(), "- SYNTAX ERROR; No valid procedure body");
 			}
 		}
 		else {
-			logger_->error(token_->getPosition(), "- SYNTAX ERROR; \";\" is missing");
+			logger_->error(token_.getPosition(), "- SYNTAX ERROR; \";\" is missing");
 		}
 	}
 	else {
-		logger_->error(token_->getPosition(), "- SYNTAX ERROR; No valid procedure head");
+		logger_->error(token_.getPosition(), "- SYNTAX ERROR; No valid procedure head");
 	}
+	symbolTable_.exitScope();
 	return nullptr;
 }
 
-std::shared_ptr<const Expression> Parser::expression() {
+static ExpressionOp operation(const TokenType type) {
+	switch (type)
+	{
+	case TokenType::op_plus: return ExpressionOp::add;
+	case TokenType::op_minus: return ExpressionOp::subtract;
+	case TokenType::op_or: return ExpressionOp::logical_or;
+	case TokenType::op_times: return ExpressionOp::multiply;
+	case TokenType::op_div: return ExpressionOp::divide;
+	case TokenType::op_mod: return ExpressionOp::modulo;
+	case TokenType::op_and: return ExpressionOp::logical_and;
+	case TokenType::op_eq: return ExpressionOp::equal;
+	case TokenType::op_neq: return ExpressionOp::not_equal;
+	case TokenType::op_lt: return ExpressionOp::less;
+	case TokenType::op_leq: return ExpressionOp::less_equal;
+	case TokenType::op_gt: return ExpressionOp::greater;
+	default: return ExpressionOp::greater_equal;
+	}
+}
+
+uint32_t Parser::emit(const ExpressionNode &node) {
+	expressionNodes_.push_back(node);
+	return (uint32_t) (expressionNodes_.size() - 1);
+}
+
+const Expression* Parser::expression() {
+	TIME_PHASE(expression);
 	// SimpleExpression [("=" | "#" | "<" | "<=" | ">" | ">=") SimpleExpression] -> Optional
 
+	const uint32_t begin = (uint32_t) expressionNodes_.size();
 	auto lhs = simple_expression();
-	if (lhs != nullptr)
+	if (lhs != ExpressionNode::NONE)
 	{
-		if (token_->getType() == TokenType::op_eq || token_->getType() == TokenType::op_neq || token_->getType() == TokenType::op_lt || token_->getType() == TokenType::op_leq || token_->getType() == TokenType::op_gt || token_->getType() == TokenType::op_geq)
+		if (token_.getType() == TokenType::op_eq || token_.getType() == TokenType::op_neq || token_.getType() == TokenType::op_lt || token_.getType() == TokenType::op_leq || token_.getType() == TokenType::op_gt || token_.getType() == TokenType::op_geq)
 		{
-			auto operand = token_->getType();
+			auto operand = token_.getType();
 			token_ = scanner_->nextToken();
 			auto rhs = simple_expression();
-			if (rhs != nullptr)
+			if (rhs != ExpressionNode::NONE)
 			{
-				if (lhs->type == rhs->type)
+				if (expressionNodes_[lhs].type == expressionNodes_[rhs].type)
 				{
-					if ((operand == TokenType::op_lt || operand == TokenType::op_leq || operand == TokenType::op_gt || operand == TokenType::op_geq) && lhs->type != PrimitiveType::Number)
+					if ((operand == TokenType::op_lt || operand == TokenType::op_leq || operand == TokenType::op_gt || operand == TokenType::op_geq) && expressionNodes_[lhs].type != PrimitiveType::Number)
 					{
-						logger_->error(token_->getPosition(), "- SEMANTIC ERROR; \"<\" | \"<=\" | \">\" | \">=\" should be with numbers");
+						logger_->error(token_.getPosition(), "- SEMANTIC ERROR; \"<\" | \"<=\" | \">\" | \">=\" should be with numbers");
 					}
 					else {
-						return std::make_shared<const Expression>(lhs, operand, rhs);
+						emit(ExpressionNode::binary(operation(operand), PrimitiveType::Boolean, lhs, rhs));
+						return arena_->create<Expression>(PrimitiveType::Boolean, begin, (uint32_t) expressionNodes_.size());
 					}
 				}
 				else {
-					logger_->error(token_->getPosition(), "- SEMANTIC ERROR; lhs and rhs type should be same");
+					logger_->error(token_.getPosition(), "- SEMANTIC ERROR; lhs and rhs type should be same");
 				}
 			}
 			else {
-				logger_->error(token_->getPosition(), "- SYNTAX ERROR; No rhs simple expression after an operand");
+				logger_->error(token_.getPosition(), "- SYNTAX ERROR; No rhs simple expression after an operand");
 			}
 		}
 		else {
-			return std::make_shared<const Expression>(lhs);
+			return arena_->create<Expression>(expressionNodes_[lhs].type, begin, (uint32_t) expressionNodes_.size());
 		}
 	}
 	else {
-		logger_->error(token_->getPosition(), "- SYNTAX ERROR; No simple expression");
+		logger_->error(token_.getPosition(), "- SYNTAX ERROR; No simple expression");
 	}
+	// the nodes of an invalid expression are dropped
+	expressionNodes_.resize(begin);
 	return nullptr;
 }
 
-std::shared_ptr<const SimpleExpression> Parser::simple_expression() {
+uint32_t Parser::simple_expression() {
 	// ["+" | "-"] term {("+" | "-" | "OR") term}
 	auto operand = TokenType::null;
-	if (token_->getType() == TokenType::op_plus || token_->getType() == TokenType::op_minus) {
-		operand = token_->getType();
+	if (token_.getType() == TokenType::op_plus || token_.getType() == TokenType::op_minus) {
+		operand = token_.getType();
 		token_ = scanner_->nextToken();
 	}
 	auto _term = term();
-	if (_term != nullptr)
+	if (_term != ExpressionNode::NONE)
 	{
-		if (operand != TokenType::null && _term->type != PrimitiveType::Number)
+		const PrimitiveType type = expressionNodes_[_term].type;
+		if (operand != TokenType::null && type != PrimitiveType::Number)
 		{
-			logger_->error(token_->getPosition(), "- SEMANTIC ERROR; \"+\" and \"-\" operands can not use without numbers");
-			return nullptr;
+			logger_->error(token_.getPosition(), "- SEMANTIC ERROR; \"+\" and \"-\" operands can not use without numbers");
+			return ExpressionNode::NONE;
 		}
-		auto simpleExpression = std::make_shared<SimpleExpression>();
-		simpleExpression->type = _term->type;
+		auto simpleExpression = ExpressionNode::NONE;
 		bool shouldRepeat = true;
 		while (shouldRepeat)
 		{
-			if (_term->type == simpleExpression->type)
+			if (expressionNodes_[_term].type == type)
 			{
-				auto element = std::make_shared<const SimpleExpressionElement>(operand, _term);
-				simpleExpression->elements.emplace_back(element);
-				if (token_->getType() == TokenType::op_plus || token_->getType() == TokenType::op_minus || token_->getType() == TokenType::op_or)
+				if (simpleExpression == ExpressionNode::NONE)
+				{
+					simpleExpression = (operand == TokenType::op_minus) ? emit(ExpressionNode::unary(ExpressionOp::negate, type, _term)) : _term;
+				}
+				else {
+					simpleExpression = emit(ExpressionNode::binary(operation(operand), type, simpleExpression, _term));
+				}
+				if (token_.getType() == TokenType::op_plus || token_.getType() == TokenType::op_minus || token_.getType() == TokenType::op_or)
 				{
-					if ((_term->type == PrimitiveType::Number && (token_->getType() == TokenType::op_plus || token_->getType() == TokenType::op_minus)) || (_term->type == PrimitiveType::Boolean && token_->getType() == TokenType::op_or))
+					if ((type == PrimitiveType::Number && (token_.getType() == TokenType::op_plus || token_.getType() == TokenType::op_minus)) || (type == PrimitiveType::Boolean && token_.getType() == TokenType::op_or))
 					{
-						operand = token_->getType();
+						operand = token_.getType();
 						token_ = scanner_->nextToken();
-						_term.reset();
 						_term = term();
-						if (_term == nullptr)
+						if (_term == ExpressionNode::NONE)
 						{
 							shouldRepeat = false;
 						}
 					}
 					else {
-						logger_->error(token_->getPosition(), "- SEMANTIC ERROR; operand and term type can not matched");
+						logger_->error(token_.getPosition(), "- SEMANTIC ERROR; operand and term type can not matched");
 						shouldRepeat = false;
 					}
 				}
@@ -433,47 +486,45 @@ std::shared_ptr<const SimpleExpression> Parser::simple_expression() {
 				}
 			}
 			else {
-				logger_->error(token_->getPosition(), "- SEMANTIC ERROR; Type inconsistency");
+				logger_->error(token_.getPosition(), "- SEMANTIC ERROR; Type inconsistency");
 				shouldRepeat = false;
 			}
 		}
 	}
 	else {
-		logger_->error(token_->getPosition(), "- SEMANTIC ERROR; No valid term");
+		logger_->error(token_.getPosition(), "- SEMANTIC ERROR; No valid term");
 	}
-	return nullptr;
+	return ExpressionNode::NONE;
 }
 
-std::shared_ptr<const Term> Parser::term() {
+uint32_t Parser::term() {
 	// factor {("*" | "DIV" | "MOD" | "&") factor} -> repetition
 	auto _factor = factor();
-	if (_factor != nullptr)
+	if (_factor != ExpressionNode::NONE)
 	{
-		auto term = std::make_shared<Term>();
-		term->type = _factor->type;
+		const PrimitiveType type = expressionNodes_[_factor].type;
+		auto term = ExpressionNode::NONE;
 		auto operand = TokenType::null;
 		bool shouldRepeat = true;
 		while (shouldRepeat)
 		{
-			if (_factor->type == term->type)
+			if (expressionNodes_[_factor].type == type)
 			{
-				auto element = std::make_shared<const TermElement>(operand, _factor);
-				term->elements.emplace_back(element);
-				if (token_->getType() == TokenType::op_times || token_->getType() == TokenType::op_div || token_->getType() == TokenType::op_mod || token_->getType() == TokenType::op_and)
+				term = (term == ExpressionNode::NONE) ? _factor : emit(ExpressionNode::binary(operation(operand), type, term, _factor));
+				if (token_.getType() == TokenType::op_times || token_.getType() == TokenType::op_div || token_.getType() == TokenType::op_mod || token_.getType() == TokenType::op_and)
 				{
-					if ((_factor->type == PrimitiveType::Number && (token_->getType() == TokenType::op_times || token_->getType() == TokenType::op_div || token_->getType() == TokenType::op_mod)) || (_factor->type == PrimitiveType::Boolean && token_->getType() == TokenType::op_and))
+					if ((type == PrimitiveType::Number && (token_.getType() == TokenType::op_times || token_.getType() == TokenType::op_div || token_.getType() == TokenType::op_mod)) || (type == PrimitiveType::Boolean && token_.getType() == TokenType::op_and))
 					{
-						operand = token_->getType();
+						operand = token_.getType();
 						token_ = scanner_->nextToken();
-						_factor.reset();
 						_factor = factor();
-						if (_factor == nullptr)
+						if (_factor == ExpressionNode::NONE)
 						{
 							shouldRepeat = false;
 						}
 					}
 					else {
-						logger_->error(token_->getPosition(), "- SEMANTIC ERROR; operand and term type can not matched");
+						logger_->error(token_.getPosition(), "- SEMANTIC ERROR; operand and term type can not matched");
 						shouldRepeat = false;
 					}
 				}
@@ -482,37 +533,37 @@ std::shared_ptr<const Term> Parser::term() {
 				}
 			}
 			else {
-				logger_->error(token_->getPosition(), "- SEMANTIC ERROR; Type inconsistency");
+				logger_->error(token_.getPosition(), "- SEMANTIC ERROR; Type inconsistency");
 				shouldRepeat = false;
 			}
 		}
 	}
 	else {
-		logger_->error(token_->getPosition(), "- SEMANTIC ERROR; No valid factor");
+		logger_->error(token_.getPosition(), "- SEMANTIC ERROR; No valid factor");
 	}
-	return nullptr;
+	return ExpressionNode::NONE;
 }
 
-std::shared_ptr<const Factor> Parser::factor() {
+uint32_t Parser::factor() {
 	// ident selector | integer | "(" expression ")" | "~" factor	
-	std::string identifier = ident();
+	Ident identifier = ident();
 	if (!identifier.empty())
 	{
 		token_ = scanner_->nextToken();
 		auto _variable = symbolTable_.lookup(identifier);
 		if (_variable != nullptr)
 		{
-			Variable* _var;
+			const Variable* _var;
 			if (_variable->nodeType_ == NodeType::variable_reference)
 			{
-				_var = static_cast<VarVariable*>(const_cast<Node*>(_variable.get()));
+				_var = static_cast<const VarVariable*>(_variable);
 			}
 			else if (_variable->nodeType_ == NodeType::constant_reference) {
-				_var = static_cast<ConstVariable*>(const_cast<Node*>(_variable.get()));
+				_var = static_cast<const ConstVariable*>(_variable);
 			}
 			else {
-				logger_->error(token_->getPosition(), "- SEMANTIC ERROR; Type variable can not be used as a factor");
-				return nullptr;
+				logger_->error(token_.getPosition(), "- SEMANTIC ERROR; Type variable can not be used as a factor");
+				return ExpressionNode::NONE;
 			}
 			auto _selector = selector();
 			if (_selector != nullptr)
@@ -521,131 +572,131 @@ std::shared_ptr<const Factor> Parser::factor() {
 				{
 					if (_var->primitiveType == _selector->type)
 					{
-						_var->selector = _selector;
+						return emit(ExpressionNode::selected(arena_->create<Selection>(_var, _selector)));
 					}
 					else {
-						logger_->error(token_->getPosition(), "- SEMANTIC ERROR; Selector type is not convenient with the variable type");
-						return nullptr;
+						logger_->error(token_.getPosition(), "- SEMANTIC ERROR; Selector type is not convenient with the variable type");
+						return ExpressionNode::NONE;
 					}
 				}
 				else {
-					logger_->error(token_->getPosition(), "- SEMANTIC ERROR; Invalid selector");
-					return nullptr;
+					logger_->error(token_.getPosition(), "- SEMANTIC ERROR; Invalid selector");
+					return ExpressionNode::NONE;
 				}
 			}
-			return std::make_shared<const VariableFactor>(std::shared_ptr<Variable>(_var));
+			return emit(ExpressionNode::reference(_var));
 		}
 		else {
-			logger_->error(token_->getPosition(), "- SEMANTIC ERROR; No variable with \"" + identifier + "\"");
+			logger_->error(token_.getPosition(), "- SEMANTIC ERROR; No variable with \"", identifier.getName(), "\"");
 		}
 	}
 	else {
-		if (token_->getType() == TokenType::const_string)
+		if (token_.getType() == TokenType::const_string)
 		{
-			const std::string str = static_cast<const StringToken*>(token_.get())->getValue();
+			// the literal is kept undecoded, see ExpressionNode::decoded()
+			std::string str = scanner_->getText(token_);
 			token_ = scanner_->nextToken();
-			return std::make_shared<const StringFactor>(str);
+			return emit(ExpressionNode::string(arena_->create<std::string>(std::move(str))));
 		}
-		else if (token_->getType() == TokenType::const_number) {
-			const int number = static_cast<const NumberToken*>(token_.get())->getValue();
+		else if (token_.getType() == TokenType::const_number) {
+			const int number = token_.getValue();
 			token_ = scanner_->nextToken();
-			return std::make_shared<const NumberFactor>(number);
+			return emit(ExpressionNode::number(number));
 		}
-		else if (token_->getType() == TokenType::const_true || token_->getType() == TokenType::const_false) {
-			const bool boolean = (token_->getType() == TokenType::const_true) ? true : false;
+		else if (token_.getType() == TokenType::const_true || token_.getType() == TokenType::const_false) {
+			const bool boolean = (token_.getType() == TokenType::const_true) ? true : false;
 			token_ = scanner_->nextToken();
-			return std::make_shared<const BooleanFactor>(boolean);
+			return emit(ExpressionNode::boolean(boolean));
 		}
-		else if (token_->getType() == TokenType::lparen) {
+		else if (token_.getType() == TokenType::lparen) {
 			token_ = scanner_->nextToken();
 			auto _expression = expression();
 			if (_expression != nullptr)
 			{
 				if (_expression->type == PrimitiveType::Number)
 				{
-					if (token_->getType() == TokenType::rparen)
+					if (token_.getType() == TokenType::rparen)
 					{
 						token_ = scanner_->nextToken();
-						return std::make_shared<const ExpressionFactor>(_expression);
+						return _expression->root();
 					}
 					else {
-						logger_->error(token_->getPosition(), "- SYNTAX ERROR; \")\" is missing.");
+						logger_->error(token_.getPosition(), "- SYNTAX ERROR; \")\" is missing.");
 					}
 				}
 				else {
-					logger_->error(token_->getPosition(), "- SEMANTIC ERROR; The expression should be number");
+					logger_->error(token_.getPosition(), "- SEMANTIC ERROR; The expression should be number");
 				}
 			}
 			else {
-				logger_->error(token_->getPosition(), "- SEMANTIC ERROR; No valid expression");
+				logger_->error(token_.getPosition(), "- SEMANTIC ERROR; No valid expression");
 			}
 		}
-		else if (token_->getType() == TokenType::op_not) {
+		else if (token_.getType() == TokenType::op_not) {
 			token_ = scanner_->nextToken();
 			auto _factor = factor();
-			if (_factor != nullptr)
+			if (_factor != ExpressionNode::NONE)
 			{
-				if (_factor->type == PrimitiveType::Boolean)
+				if (expressionNodes_[_factor].type == PrimitiveType::Boolean)
 				{
-					return std::make_shared<const NotFactor>(_factor);
+					return emit(ExpressionNode::unary(ExpressionOp::logical_not, PrimitiveType::Boolean, _factor));
 				}
 				else {
-					logger_->error(token_->getPosition(), "- SEMANTIC ERROR; Factor is not boolean type");
+					logger_->error(token_.getPosition(), "- SEMANTIC ERROR; Factor is not boolean type");
 				}
 			}
 			else {
-				logger_->error(token_->getPosition(), "- SEMANTIC ERROR; No valid factor");
+				logger_->error(token_.getPosition(), "- SEMANTIC ERROR; No valid factor");
 			}
 		}
 		else {
-			logger_->error(token_->getPosition(), "- SYNTAX ERROR; Factor is not valid.");
+			logger_->error(token_.getPosition(), "- SYNTAX ERROR; Factor is not valid.");
 		}
 	}
-	return nullptr;
+	return ExpressionNode::NONE;
 }
 
-std::shared_ptr<const Type> Parser::type() {
+const Type* Parser::type() {
 	// ident | ArrayType | RecordType
-	std::string name = ident();
+	Ident name = ident();
 	if (!name.empty())
 	{
 		token_ = scanner_->nextToken();
 		PrimitiveType primitiveType;
-		if (name == "INTEGER" || name == "LONGINT")
+		if (name == integerIdent_ || name == longintIdent_)
 		{
 			primitiveType = PrimitiveType::Number;
 		}
-		else if (name == "CHAR") {
+		else if (name == charIdent_) {
 			primitiveType = PrimitiveType::String;
 		}
-		else if (name == "BOOLEAN") {
+		else if (name == booleanIdent_) {
 			primitiveType = PrimitiveType::Boolean;
 		}
 		else {
 			auto typeNode = symbolTable_.lookup(name);
 			if (typeNode != nullptr && typeNode->nodeType_ == NodeType::type_reference)
 			{
-				auto _type = static_cast<Type*>(const_cast<Node*>(typeNode.get()));
-				return std::shared_ptr<Type>(_type);
+				return static_cast<const TypeVariable*>(typeNode)->type;
 			}
 			else {
-				logger_->error(token_->getPosition(), "- SEMANTIC ERROR; No defined type by identifier \"" + name + "\"");
+				logger_->error(token_.getPosition(), "- SEMANTIC ERROR; No defined type by identifier \"", name.getName(), "\"");
 				return nullptr;
 			}
 		}
-		return std::make_shared<Type>(primitiveType);
+		return arena_->create<Type>(primitiveType);
 	}
-	else if (token_->getType() == TokenType::kw_array) {
+	else if (token_.getType() == TokenType::kw_array) {
 		return array_type();
 	}
-	else if (token_->getType() == TokenType::kw_record) {
+	else if (token_.getType() == TokenType::kw_record) {
 		return record_type();
 	}
-	logger_->error(token_->getPosition(), "- SYNTAX ERROR; type is not valid.");
+	logger_->error(token_.getPosition(), "- SYNTAX ERROR; type is not valid.");
 	return nullptr;
 }
 
-std::shared_ptr<const ArrayType> Parser::array_type() {
+const ArrayType* Parser::array_type() {
 	// "ARRAY" expression "OF" type.
 	token_ = scanner_->nextToken();
 	auto _expression = expression();
@@ -653,60 +704,60 @@ std::shared_ptr<const ArrayType> Parser::array_type() {
 	{
 		if (_expression->type == PrimitiveType::Number)
 		{
-			if (token_->getType() == TokenType::kw_of)
+			if (token_.getType() == TokenType::kw_of)
 			{
 				token_ = scanner_->nextToken();
 				auto _type = type();
 				if (_type != nullptr)
 				{
-					return std::make_shared<const ArrayType>(_expression, _type);
+					return arena_->create<ArrayType>(_expression, _type);
 				}
 				else {
-					logger_->error(token_->getPosition(), "- SEMANTIC ERROR; No valid type");
+					logger_->error(token_.getPosition(), "- SEMANTIC ERROR; No valid type");
 				}
 			}
 			else {
-				logger_->error(token_->getPosition(), "- SYNTAX ERROR; \"OF\" keyword is missing.");
+				logger_->error(token_.getPosition(), "- SYNTAX ERROR; \"OF\" keyword is missing.");
 			}
 		}
 		else {
-			logger_->error(token_->getPosition(), "- SEMANTIC ERROR; Invalid array dimension");
+			logger_->error(token_.getPosition(), "- SEMANTIC ERROR; Invalid array dimension");
 		}
 	}
 	else {
-		logger_->error(token_->getPosition(), "- SEMANTIC ERROR; No valid expression");
+		logger_->error(token_.getPosition(), "- SEMANTIC ERROR; No valid expression");
 	}
 	return nullptr;
 }
 
-std::shared_ptr<const RecordType> Parser::record_type() {
+const RecordType* Parser::record_type() {
 	// "RECORD" FieldList {";" FieldList} "END"
 	token_ = scanner_->nextToken();
-	std::vector<std::shared_ptr<const Variable>> fieldList = field_list();
+	std::vector<const Variable*> fieldList = field_list();
 	if (fieldList.size() != 0)
 	{
-		auto record = std::make_shared<RecordType>();
+		auto record = arena_->create<RecordType>();
+		std::unordered_set<unsigned int> fieldIds;
 		for (auto& field : fieldList) {
 			record->fieldListNodes.emplace_back(field);
+			fieldIds.insert(field->identifier.getId());
 		}
 		fieldList.clear();
 		bool shouldRepeat = true;
 		while (shouldRepeat)
 		{
-			if (token_->getType() == TokenType::semicolon)
+			if (token_.getType() == TokenType::semicolon)
 			{
 				token_ = scanner_->nextToken();
 				fieldList = field_list();
 				for (auto& field : fieldList) {
-					for (auto& recordField : record->fieldListNodes) {
-						if (field->identifier == recordField->identifier)
-						{
-							logger_->error(token_->getPosition(), "- SEMANTIC ERROR; " + field->identifier + " has been used in the record scope");
-							shouldRepeat = false;
-						}
-						else {
-							record->fieldListNodes.emplace_back(field);
-						}
+					if (!fieldIds.insert(field->identifier.getId()).second)
+					{
+						logger_->error(token_.getPosition(), "- SEMANTIC ERROR; ", field->identifier.getName(), " has been used in the record scope");
+						shouldRepeat = false;
+					}
+					else {
+						record->fieldListNodes.emplace_back(field);
 					}
 				}
 				if (shouldRepeat == false)
@@ -718,71 +769,67 @@ std::shared_ptr<const RecordType> Parser::record_type() {
 				shouldRepeat = false;
 			}
 		}
-		if (token_->getType() == TokenType::kw_end)
+		if (token_.getType() == TokenType::kw_end)
 		{
 			token_ = scanner_->nextToken();
 			return record;
 		}
 		else {
-			logger_->error(token_->getPosition(), "- SYNTAX ERROR; \"END\" keyword is missing.");
+			logger_->error(token_.getPosition(), "- SYNTAX ERROR; \"END\" keyword is missing.");
 		}
 	}
 	else {
-		logger_->error(token_->getPosition(), "- SEMANTIC ERROR; A record has no valid or unique identifiers.");
+		logger_->error(token_.getPosition(), "- SEMANTIC ERROR; A record has no valid or unique identifiers.");
 	}
 	return nullptr;
 }
 
-const std::vector<std::shared_ptr<const Variable>> Parser::field_list() {
+const std::vector<const Variable*> Parser::field_list() {
 	// [IdentList ":" type] -> optional
-	std::vector<std::shared_ptr<const Variable>> fieldList;
-	const std::vector<std::string> identList = ident_list();
+	std::vector<const Variable*> fieldList;
+	const std::vector<Ident> identList = ident_list();
 	if (identList.size() != 0)
 	{
-		if (token_->getType() == TokenType::colon)
+		if (token_.getType() == TokenType::colon)
 		{
 			token_ = scanner_->nextToken();
 			auto _type = type();
 			if (_type != nullptr)
 			{
 				for (auto& identifier : identList) {
-					fieldList.emplace_back(std::make_shared<const Variable>(identifier, _type));
+					fieldList.emplace_back(arena_->create<Variable>(identifier, _type));
 				}
 			}
 			else {
-				logger_->error(token_->getPosition(), "- SEMANTIC ERROR; No valid type");
+				logger_->error(token_.getPosition(), "- SEMANTIC ERROR; No valid type");
 			}
 		}
 		else {
-			logger_->error(token_->getPosition(), "- SYNTAX ERROR; \":\" is missing");
+			logger_->error(token_.getPosition(), "- SYNTAX ERROR; \":\" is missing");
 		}
 	}
 	return fieldList;
 }
 
-const std::vector<std::string> Parser::ident_list() {
+const std::vector<Ident> Parser::ident_list() {
 	// ident {"," ident}
-	std::vector<std::string> identList;
+	std::vector<Ident> identList;
+	std::unordered_set<unsigned int> identIds;
 	bool shouldRepeat = true;
 	while (shouldRepeat)
 	{
-		std::string name = ident();
+		Ident name = ident();
 		if (!name.empty())
 		{
-			bool isNameOk = true;
-			for (auto identifier : identList) {
-				if (name == identifier)
-				{
-					isNameOk = false;
-					logger_->error(token_->getPosition(), "- SEMANTIC ERROR; Identifier \"" + name + "\" has been used");
-				}
-			}
-			if (isNameOk)
+			if (!identIds.insert(name.getId()).second)
 			{
+				logger_->error(token_.getPosition(), "- SEMANTIC ERROR; Identifier \"", name.getName(), "\" has been used");
+			}
+			else {
 				identList.emplace_back(name);
 			}
 			token_ = scanner_->nextToken();
-			if (token_->getType() != TokenType::comma)
+			if (token_.getType() != TokenType::comma)
 			{
 				shouldRepeat = false;
 			}
@@ -792,59 +839,60 @@ const std::vector<std::string> Parser::ident_list() {
 		}
 		else {
 			shouldRepeat = false;
-			//logger_->error(token_->getPosition(), "- SYNTAX ERROR; Identifier is not valid.");
+			//logger_->error(token_.getPosition(), "- SYNTAX ERROR; Identifier is not valid.");
 		}
 	}
 	return identList;
 }
 
-std::shared_ptr<const ProcedureHead> Parser::procedure_heading() {
+const ProcedureHead* Parser::procedure_heading() {
 	// "PROCEDURE" ident [FormalParameters]
 	token_ = scanner_->nextToken();
-	std::string identifier = ident();
+	Ident identifier = ident();
 	if (!identifier.empty())
 	{
 		token_ = scanner_->nextToken();
-		auto procedureHead = std::make_shared<ProcedureHead>(identifier);
+		auto procedureHead = arena_->create<ProcedureHead>(identifier);
 		for (auto _variable : formal_parameters()) {
 			procedureHead->parameters.emplace_back(_variable);
+			symbolTable_.insert(_variable->identifier, _variable);
 		}
 		return procedureHead;
 	}
 	else {
-		logger_->error(token_->getPosition(), "- SYNTAX ERROR; Procedure name is not valid.");
+		logger_->error(token_.getPosition(), "- SYNTAX ERROR; Procedure name is not valid.");
 	}
 	return nullptr;
 }
 
-std::shared_ptr<const ProcedureBody> Parser::procedure_body(const std::string _procedureIdentifier) {
+const ProcedureBody* Parser::procedure_body(const Ident _procedureIdentifier) {
 	// declarations ["BEGIN" StatementSequence] "END" ident
 
-	auto body = std::make_shared<ProcedureBody>();
-	const std::vector<std::shared_ptr<const Variable>> variableDeclarations = declarations();
-	for (auto declaration : variableDeclarations) {
-		bool isDeclarationOk = true;
-		for (auto bodyDeclarations : body->declarations) {
-			if (declaration->identifier == bodyDeclarations->identifier) {
-				isDeclarationOk = false;
-				logger_->error(token_->getPosition(), "- SEMANTIC ERROR; Identifier \"" + declaration->identifier + "\" has been used");
+	auto body = arena_->create<ProcedureBody>();
+	const std::vector<const Variable*> variableDeclarations = declarations();
+	{
+		TRACE_SCOPE("semantic check");
+		for (auto declaration : variableDeclarations) {
+			// the scope of the procedure is still open and also holds its parameters
+			if (symbolTable_.lookup(declaration->identifier) != declaration) {
+				logger_->error(token_.getPosition(), "- SEMANTIC ERROR; Identifier \"", declaration->identifier.getName(), "\" has been used");
+			}
+			else
+			{
+				body->declarations.emplace_back(declaration);
 			}
-		}
-		if (isDeclarationOk)
-		{
-			body->declarations.emplace_back(declaration);
 		}
 	}
-	if (token_->getType() == TokenType::kw_begin)
+	if (token_.getType() == TokenType::kw_begin)
 	{
 		token_ = scanner_->nextToken();
-		const std::vector<std::shared_ptr<const Statement>> statementSequence = statement_sequence();
+		const std::vector<const Statement*> statementSequence = statement_sequence();
 		body->statements = statementSequence;
 	}
-	if (token_->getType() == TokenType::kw_end)
+	if (token_.getType() == TokenType::kw_end)
 	{
 		token_ = scanner_->nextToken();
-		std::string name = ident();
+		Ident name = ident();
 		if (!name.empty())
 		{
 			token_ = scanner_->nextToken();
@@ -853,46 +901,44 @@ std::shared_ptr<const ProcedureBody> Parser::procedure_body(const std::string _p
 				return body;
 			}
 			else {
-				logger_->error(token_->getPosition(), "- SEMANTIC ERROR; Procedure name is not same.");
+				logger_->error(token_.getPosition(), "- SEMANTIC ERROR; Procedure name is not same.");
 			}
 		}
 		else {
-			logger_->error(token_->getPosition(), "- SYNTAX ERROR; Procedure name is not identified.");
+			logger_->error(token_.getPosition(), "- SYNTAX ERROR; Procedure name is not identified.");
 		}
 	}
 	else {
-		logger_->error(token_->getPosition(), "- SYNTAX ERROR; \"END\" keyword is missing.");
+		logger_->error(token_.getPosition(), "- SYNTAX ERROR; \"END\" keyword is missing.");
 	}
 	return nullptr;
 }
 
-const std::vector<std::shared_ptr<const Variable>> Parser::formal_parameters() {
+const std::vector<const Variable*> Parser::formal_parameters() {
 	// "(" [FPSection {";" FPSection} ] ")"
-	std::vector<std::shared_ptr<const Variable>> formalParameters;
-	if (token_->getType() == TokenType::lparen)
+	std::vector<const Variable*> formalParameters;
+	if (token_.getType() == TokenType::lparen)
 	{
 		token_ = scanner_->nextToken();
 		formalParameters = fp_section();
 		if (formalParameters.size() > 0)
 		{
+			std::unordered_set<unsigned int> parameterIds;
+			for (auto parameter : formalParameters) {
+				parameterIds.insert(parameter->identifier.getId());
+			}
 			bool shouldRepeat = true;
 			while (shouldRepeat)
 			{
-				if (token_->getType() == TokenType::semicolon)
+				if (token_.getType() == TokenType::semicolon)
 				{
 					token_ = scanner_->nextToken();
 					for (auto p : fp_section()) {
-						bool isParameterOk = true;
-						for (auto parameter : formalParameters) {
-							if (p->identifier == parameter->identifier)
-							{
-								logger_->error(token_->getPosition(), "- SEMANTIC ERROR; Parameter identifier \"" + p->identifier + "\" has been used");
-							}
-						}
-						if (isParameterOk)
+						if (!parameterIds.insert(p->identifier.getId()).second)
 						{
-							formalParameters.emplace_back(p);
+							logger_->error(token_.getPosition(), "- SEMANTIC ERROR; Parameter identifier \"", p->identifier.getName(), "\" has been used");
 						}
+						formalParameters.emplace_back(p);
 					}
 				}
 				else {
@@ -900,33 +946,33 @@ const std::vector<std::shared_ptr<const Variable>> Parser::formal_parameters() {
 				}
 			}
 		}
-		if (token_->getType() == TokenType::rparen)
+		if (token_.getType() == TokenType::rparen)
 		{
 			token_ = scanner_->nextToken();
 		}
 		else {
-			logger_->error(token_->getPosition(), "- SYNTAX ERROR; \")\" is missing.");
+			logger_->error(token_.getPosition(), "- SYNTAX ERROR; \")\" is missing.");
 		}
 	}
 	else {
-		logger_->error(token_->getPosition(), "- SYNTAX ERROR; \"(\" is missing.");
+		logger_->error(token_.getPosition(), "- SYNTAX ERROR; \"(\" is missing.");
 	}
 	return formalParameters;
 }
 
-const std::vector<std::shared_ptr<const Variable>> Parser::fp_section() {
+const std::vector<const Variable*> Parser::fp_section() {
 	// ["VAR"]	IdentList ":" type
-	std::vector<std::shared_ptr<const Variable>> parameters;
+	std::vector<const Variable*> parameters;
 	bool hasVarKeyword = false;
-	if (token_->getType() == TokenType::kw_var)
+	if (token_.getType() == TokenType::kw_var)
 	{
 		hasVarKeyword = true;
 		token_ = scanner_->nextToken();
 	}
-	const std::vector<std::string> identList = ident_list();
+	const std::vector<Ident> identList = ident_list();
 	if (identList.size() != 0)
 	{
-		if (token_->getType() == TokenType::colon)
+		if (token_.getType() == TokenType::colon)
 		{
 			token_ = scanner_->nextToken();
 			auto _type = type();
@@ -934,28 +980,29 @@ const std::vector<std::shared_ptr<const Variable>> Parser::fp_section() {
 			{
 				if (hasVarKeyword && (_type->primitiveType == PrimitiveType::Array || _type->primitiveType == PrimitiveType::Record))
 				{
-					logger_->error(token_->getPosition(), "- SEMANTIC ERROR; \"VAR\" keyword can not be used with structured types.");
+					logger_->error(token_.getPosition(), "- SEMANTIC ERROR; \"VAR\" keyword can not be used with structured types.");
 				}
 				else {
 					for (auto identifier : identList) {
-						parameters.emplace_back(std::make_shared<const Variable>(identifier, _type));
+						parameters.emplace_back(arena_->create<VarVariable>(identifier, _type));
 					}
 				}
 			}
 			else {
-				logger_->error(token_->getPosition(), "- SEMANTIC ERROR; No valid type.");
+				logger_->error(token_.getPosition(), "- SEMANTIC ERROR; No valid type.");
 			}
 		}
 		else {
-			logger_->error(token_->getPosition(), "- SYNTAX ERROR; \":\" is missing.");
+			logger_->error(token_.getPosition(), "- SYNTAX ERROR; \":\" is missing.");
 		}
 	}
 	return parameters;
 }
 
-const std::vector<std::shared_ptr<const Statement>> Parser::statement_sequence() {
+const std::vector<const Statement*> Parser::statement_sequence() {
+	TIME_PHASE(statement_sequence);
 	// statement {";" statement}
-	std::vector<std::shared_ptr<const Statement>> statementList;
+	std::vector<const Statement*> statementList;
 	auto s = statement();
 	if (s != nullptr)
 	{
@@ -963,10 +1010,10 @@ const std::vector<std::shared_ptr<const Statement>> Parser::statement_sequence()
 		bool shouldProceed = true;
 		while (shouldProceed)
 		{
-			if (token_->getType() == TokenType::semicolon)
+			if (token_.getType() == TokenType::semicolon)
 			{
 				token_ = scanner_->nextToken();
-				s.reset();
+				s = nullptr;
 				s = statement();
 				if (s == nullptr)
 				{
@@ -984,17 +1031,17 @@ const std::vector<std::shared_ptr<const Statement>> Parser::statement_sequence()
 	return statementList;
 }
 
-std::shared_ptr<const Statement> Parser::statement() {
+const Statement* Parser::statement() {
 	// [assignment | ProcedureCall | IfStatement | WhileStatement]
-	if (token_->getType() == TokenType::kw_if)
+	if (token_.getType() == TokenType::kw_if)
 	{
 		return if_statement();
 	}
-	else if (token_->getType() == TokenType::kw_while) {
+	else if (token_.getType() == TokenType::kw_while) {
 		return while_statement();
 	}
 	else {
-		std::string identifier = ident();
+		Ident identifier = ident();
 		if (!identifier.empty())
 		{
 			token_ = scanner_->nextToken();
@@ -1003,41 +1050,35 @@ std::shared_ptr<const Statement> Parser::statement() {
 			{
 				if (variable->nodeType_ == NodeType::constant_reference || variable->nodeType_ == NodeType::type_reference)
 				{
-					logger_->error(token_->getPosition(), "- SEMANTIC ERROR; Constant or Type declarations can not be changed");
+					logger_->error(token_.getPosition(), "- SEMANTIC ERROR; Constant or Type declarations can not be changed");
 				}
 				else if (variable->nodeType_ == NodeType::variable_reference) {
-					auto _var = static_cast<VarVariable*>(const_cast<Node*>(variable.get()));
+					auto _var = static_cast<const VarVariable*>(variable);
 					auto _selector = selector();
-					if (_selector != nullptr)
+					if (_selector != nullptr && _var->primitiveType != _selector->type)
 					{
-						if (_var->primitiveType == _selector->type)
-						{
-							_var->selector = _selector;
-						}
-						else {
-							logger_->error(token_->getPosition(), "- SEMANTIC ERROR; Selector type is not convenient with the variable type");
-							return nullptr;
-						}
+						logger_->error(token_.getPosition(), "- SEMANTIC ERROR; Selector type is not convenient with the variable type");
+						return nullptr;
 					}
-					auto _assignment = assignment();
+					auto _assignment = assignment(_var, _selector);
 					if (_assignment != nullptr)
 					{
 						if (_var->primitiveType == _assignment->expression->type) {
 							return _assignment;
 						}
 						else {
-							logger_->error(token_->getPosition(), "- SEMANTIC ERROR; Variable and expression type do not match");
+							logger_->error(token_.getPosition(), "- SEMANTIC ERROR; Variable and expression type do not match");
 						}
 					}
 					else {
-						logger_->error(token_->getPosition(), "- SEMANTIC ERROR; No valid assignment");
+						logger_->error(token_.getPosition(), "- SEMANTIC ERROR; No valid assignment");
 					}
 				}
 				else if (variable->nodeType_ == NodeType::procedure) {
-					auto _procedureCall = procedure_call();
+					auto _procedure = static_cast<const ProcedureVariable*>(variable);
+					auto _procedureCall = procedure_call(_procedure);
 					if (_procedureCall != nullptr)
 					{
-						auto _procedure = static_cast<ProcedureVariable*>(const_cast<Node*>(variable.get()));
 						if (_procedureCall->actualParameters.size() == _procedure->parameters.size())
 						{
 							bool isParameterTypesOk = true;
@@ -1053,57 +1094,57 @@ std::shared_ptr<const Statement> Parser::statement() {
 								return _procedureCall;
 							}
 							else {
-								logger_->error(token_->getPosition(), "- SEMANTIC ERROR; Actual parameters types are not equal corresponding formal parameter type");
+								logger_->error(token_.getPosition(), "- SEMANTIC ERROR; Actual parameters types are not equal corresponding formal parameter type");
 							}
 						}
 						else {
-							logger_->error(token_->getPosition(), "- SEMANTIC ERROR; Actual parameters number is not equal formal parameters number of procedure");
+							logger_->error(token_.getPosition(), "- SEMANTIC ERROR; Actual parameters number is not equal formal parameters number of procedure");
 						}
 					}
 					else {
-						logger_->error(token_->getPosition(), "- SEMANTIC ERROR; No valid procedure calling");
+						logger_->error(token_.getPosition(), "- SEMANTIC ERROR; No valid procedure calling");
 					}
 				}
 			}
 			else {
-				logger_->error(token_->getPosition(), "- SEMANTIC ERROR; No valid identifier");
+				logger_->error(token_.getPosition(), "- SEMANTIC ERROR; No valid identifier");
 			}
 		}
 	}
 	return nullptr;
 }
 
-std::shared_ptr<const AssignmentStatement> Parser::assignment() {
+const AssignmentStatement* Parser::assignment(const Variable* _variable, const Selector* _selector) {
 	// ident selector ":=" expression
-	if (token_->getType() == TokenType::op_becomes)
+	if (token_.getType() == TokenType::op_becomes)
 	{
 		token_ = scanner_->nextToken();
 		auto _expression = expression();
 		if (_expression != nullptr)
 		{
-			return std::make_shared<AssignmentStatement>(_expression);
+			return arena_->create<AssignmentStatement>(_variable, _selector, _expression);
 		}
 		else {
-			logger_->error(token_->getPosition(), "- SEMANTIC ERROR; No valid expression after \":=\"");
+			logger_->error(token_.getPosition(), "- SEMANTIC ERROR; No valid expression after \":=\"");
 		}
 	}
 	else {
-		logger_->error(token_->getPosition(), "- SYNTAX ERROR; \":=\" is missing.");
+		logger_->error(token_.getPosition(), "- SYNTAX ERROR; \":=\" is missing.");
 	}
 	return nullptr;
 }
 
-std::shared_ptr<const ProcedureCallStatement> Parser::procedure_call() {
+const ProcedureCallStatement* Parser::procedure_call(const Variable* _procedure) {
 	// ident selector [ActualParameters]
-	auto procedureCall = std::make_shared<ProcedureCallStatement>();
+	auto procedureCall = arena_->create<ProcedureCallStatement>(_procedure);
 	procedureCall->actualParameters = actual_parameters();
 	return procedureCall;
 }
 
-const std::vector<std::shared_ptr<const Expression>> Parser::actual_parameters() {
+const std::vector<const Expression*> Parser::actual_parameters() {
 	// "(" [expression {"," expression}] ")"
-	std::vector<std::shared_ptr<const Expression>> actualParameters;
-	if (token_->getType() == TokenType::lparen)
+	std::vector<const Expression*> actualParameters;
+	if (token_.getType() == TokenType::lparen)
 	{
 		token_ = scanner_->nextToken();
 		auto _expression = expression();
@@ -1113,10 +1154,10 @@ const std::vector<std::shared_ptr<const Expression>> Parser::actual_parameters()
 			bool shouldRepeat = true;
 			while (shouldRepeat)
 			{
-				if (token_->getType() == TokenType::comma)
+				if (token_.getType() == TokenType::comma)
 				{
 					token_ = scanner_->nextToken();
-					_expression.reset();
+					_expression = nullptr;
 					_expression = expression();
 					if (_expression != nullptr)
 					{
@@ -1124,7 +1165,7 @@ const std::vector<std::shared_ptr<const Expression>> Parser::actual_parameters()
 					}
 					else {
 						shouldRepeat = false;
-						logger_->error(token_->getPosition(), "- SEMANTIC ERROR; No valid expression after \",\"");
+						logger_->error(token_.getPosition(), "- SEMANTIC ERROR; No valid expression after \",\"");
 					}
 				}
 				else {
@@ -1132,21 +1173,21 @@ const std::vector<std::shared_ptr<const Expression>> Parser::actual_parameters()
 				}
 			}
 		}
-		if (token_->getType() == TokenType::rparen)
+		if (token_.getType() == TokenType::rparen)
 		{
 			token_ = scanner_->nextToken();
 		}
 		else {
-			logger_->error(token_->getPosition(), "- SYNTAX ERROR; \")\" is missing");
+			logger_->error(token_.getPosition(), "- SYNTAX ERROR; \")\" is missing");
 		}
 	}
 	else {
-		logger_->error(token_->getPosition(), "- SYNTAX ERROR; \"(\" is missing");
+		logger_->error(token_.getPosition(), "- SYNTAX ERROR; \"(\" is missing");
 	}
 	return actualParameters;
 }
 
-std::shared_ptr<const IfStatement> Parser::if_statement() {
+const IfStatement* Parser::if_statement() {
 	// "IF" expression "THEN" StatementSequence {"ELSIF" expression "THEN" StatementSequence} ["ELSE" StatementSequence] "END"
 	token_ = scanner_->nextToken();
 	auto _expression = expression();
@@ -1154,15 +1195,15 @@ std::shared_ptr<const IfStatement> Parser::if_statement() {
 	{
 		if (_expression->type != PrimitiveType::Boolean)
 		{
-			if (token_->getType() == TokenType::kw_then)
+			if (token_.getType() == TokenType::kw_then)
 			{
-				auto ifStatement = std::make_shared<IfStatement>(_expression);
+				auto ifStatement = arena_->create<IfStatement>(_expression);
 				token_ = scanner_->nextToken();
-				const std::vector<std::shared_ptr<const Statement>> statementList = statement_sequence();
+				const std::vector<const Statement*> statementList = statement_sequence();
 				for (auto _statement : statementList) {
 					ifStatement->statements.emplace_back(_statement);
 				}
-				if (token_->getType() == TokenType::kw_elsif)
+				if (token_.getType() == TokenType::kw_elsif)
 				{
 					bool shouldProceed = true;
 					while (shouldProceed)
@@ -1173,71 +1214,71 @@ std::shared_ptr<const IfStatement> Parser::if_statement() {
 						{
 							if (_expression->type != PrimitiveType::Boolean)
 							{
-								if (token_->getType() == TokenType::kw_then) {
-									auto elseIfStatement = std::make_shared<ElseIf>(_innerExpression);
+								if (token_.getType() == TokenType::kw_then) {
+									auto elseIfStatement = arena_->create<ElseIf>(_innerExpression);
 									token_ = scanner_->nextToken();
-									const std::vector<std::shared_ptr<const Statement>> innerStatementList = statement_sequence();
+									const std::vector<const Statement*> innerStatementList = statement_sequence();
 									for (auto _innerStatement : statementList) {
 										elseIfStatement->statements.emplace_back(_innerStatement);
 									}
 									ifStatement->elseIfNodes.emplace_back(elseIfStatement);
-									if (token_->getType() != TokenType::kw_elsif)
+									if (token_.getType() != TokenType::kw_elsif)
 									{
 										shouldProceed = false;
 									}
 								}
 								else {
-									logger_->error(token_->getPosition(), "- SYNTAX ERROR; \"THEN\" keyword is missing.");
+									logger_->error(token_.getPosition(), "- SYNTAX ERROR; \"THEN\" keyword is missing.");
 									shouldProceed = false;
 									return nullptr;
 								}
 							}
 							else {
-								logger_->error(token_->getPosition(), "- SEMANTIC ERROR; Expression is not boolean type");
+								logger_->error(token_.getPosition(), "- SEMANTIC ERROR; Expression is not boolean type");
 								return nullptr;
 							}
 						}
 						else {
-							logger_->error(token_->getPosition(), "- SEMANTIC ERROR; No valid expression in else if block");
+							logger_->error(token_.getPosition(), "- SEMANTIC ERROR; No valid expression in else if block");
 							return nullptr;
 						}
 
 					}
 				}
-				if (token_->getType() == TokenType::kw_else)
+				if (token_.getType() == TokenType::kw_else)
 				{
 					token_ = scanner_->nextToken();
-					auto elseStatement = std::make_shared<Else>();
-					const std::vector<std::shared_ptr<const Statement>> innerStatementList = statement_sequence();
+					auto elseStatement = arena_->create<Else>();
+					const std::vector<const Statement*> innerStatementList = statement_sequence();
 					for (auto _innerStatement : statementList) {
 						elseStatement->statements.emplace_back(_innerStatement);
 					}
 					ifStatement->elseNode = elseStatement;
 				}
-				if (token_->getType() == TokenType::kw_end)
+				if (token_.getType() == TokenType::kw_end)
 				{
 					token_ = scanner_->nextToken();
 					return ifStatement;
 				}
 				else {
-					logger_->error(token_->getPosition(), "- SYNTAX ERROR; \"END\" keyword is missing.");
+					logger_->error(token_.getPosition(), "- SYNTAX ERROR; \"END\" keyword is missing.");
 				}
 			}
 			else {
-				logger_->error(token_->getPosition(), "- SYNTAX ERROR; \"THEN\" keyword is missing.");
+				logger_->error(token_.getPosition(), "- SYNTAX ERROR; \"THEN\" keyword is missing.");
 			}
 		}
 		else {
-			logger_->error(token_->getPosition(), "- SEMANTIC ERROR; Expression is not boolean");
+			logger_->error(token_.getPosition(), "- SEMANTIC ERROR; Expression is not boolean");
 		}
 	}
 	else {
-		logger_->error(token_->getPosition(), "- SEMANTIC ERROR; No valid expression");
+		logger_->error(token_.getPosition(), "- SEMANTIC ERROR; No valid expression");
 	}
 	return nullptr;
 }
 
-std::shared_ptr<const WhileStatement> Parser::while_statement() {
+const WhileStatement* Parser::while_statement() {
 	// "WHILE" expression "DO" StatementSequence "END"
 	token_ = scanner_->nextToken();
 	auto _expression = expression();
@@ -1245,53 +1286,53 @@ std::shared_ptr<const WhileStatement> Parser::while_statement() {
 	{
 		if (_expression->type == PrimitiveType::Boolean)
 		{
-			if (token_->getType() == TokenType::kw_do)
+			if (token_.getType() == TokenType::kw_do)
 			{
-				auto whileStatement = std::make_shared<WhileStatement>(_expression);
+				auto whileStatement = arena_->create<WhileStatement>(_expression);
 				token_ = scanner_->nextToken();
-				const std::vector<std::shared_ptr<const Statement>> statementList = statement_sequence();
+				const std::vector<const Statement*> statementList = statement_sequence();
 				for (auto statement : statementList) {
 					whileStatement->statements.emplace_back(statement);
 				}
-				if (token_->getType() == TokenType::kw_end)
+				if (token_.getType() == TokenType::kw_end)
 				{
 					token_ = scanner_->nextToken();
 					return whileStatement;
 				}
 				else {
-					logger_->error(token_->getPosition(), "- SYNTAX ERROR; \"END\" is missing");
+					logger_->error(token_.getPosition(), "- SYNTAX ERROR; \"END\" is missing");
 				}
 			}
 			else {
-				logger_->error(token_->getPosition(), "- SYNTAX ERROR; \"DO\" keyword is missing");
+				logger_->error(token_.getPosition(), "- SYNTAX ERROR; \"DO\" keyword is missing");
 			}
 		}
 		else {
-			logger_->error(token_->getPosition(), "- SEMANTIC ERROR; Expression is not boolean");
+			logger_->error(token_.getPosition(), "- SEMANTIC ERROR; Expression is not boolean");
 		}
 	}
 	else {
-		logger_->error(token_->getPosition(), "- SEMANTIC ERROR; No valid expression");
+		logger_->error(token_.getPosition(), "- SEMANTIC ERROR; No valid expression");
 	}
 	return nullptr;
 }
 
-const std::shared_ptr<const Selector> Parser::selector() {
+const Selector* Parser::selector() {
 	// {"." ident | "[" expression "]"} -> repetition
 	bool shouldRepeat = true;
-	std::shared_ptr<Selector> selector = nullptr;
+	Selector* selector = nullptr;
 	int selectorIndex = -1;
 	while (shouldRepeat)
 	{
 		selectorIndex++;
-		if (token_->getType() == TokenType::period)	// RECORD
+		if (token_.getType() == TokenType::period)	// RECORD
 		{
 			token_ = scanner_->nextToken();
-			std::string identifier = ident();
+			Ident identifier = ident();
 			if (!identifier.empty())
 			{
-				auto variable = std::make_shared<const Variable>(identifier);
-				auto recordSelector = std::make_shared<RecordSelector>(variable);
+				auto variable = arena_->create<Variable>(identifier);
+				auto recordSelector = arena_->create<RecordSelector>(variable);
 				if (selectorIndex == 0)
 				{
 					selector = recordSelector;
@@ -1300,27 +1341,27 @@ const std::shared_ptr<const Selector> Parser::selector() {
 					selector->innerSelectors.insert({ selectorIndex, recordSelector });
 				}
 				token_ = scanner_->nextToken();
-				if (token_->getType() != TokenType::period || token_->getType() != TokenType::lbrack)
+				if (token_.getType() != TokenType::period || token_.getType() != TokenType::lbrack)
 				{
 					shouldRepeat = false;
 				}
 			}
 			else {
-				logger_->error(token_->getPosition(), "- SYNTAX ERROR; Selector is not valid.");
+				logger_->error(token_.getPosition(), "- SYNTAX ERROR; Selector is not valid.");
 				shouldRepeat = false;
 			}
 		}
-		else if (token_->getType() == TokenType::lbrack) {	// ARRAY
+		else if (token_.getType() == TokenType::lbrack) {	// ARRAY
 			token_ = scanner_->nextToken();
 			auto _expression = expression();
 			if (_expression != nullptr)
 			{
 				if (_expression->type == PrimitiveType::Number)
 				{
-					if (token_->getType() == TokenType::rbrack)
+					if (token_.getType() == TokenType::rbrack)
 					{
 						token_ = scanner_->nextToken();
-						auto arraySelector = std::make_shared<ArraySelector>(_expression);
+						auto arraySelector = arena_->create<ArraySelector>(_expression);
 						if (selectorIndex == 0)
 						{
 							selector = arraySelector;
@@ -1328,23 +1369,23 @@ const std::shared_ptr<const Selector> Parser::selector() {
 						else if (selectorIndex > 0) {
 							selector->innerSelectors.insert({ selectorIndex, arraySelector });
 						}
-						if (token_->getType() != TokenType::period || token_->getType() != TokenType::lbrack)
+						if (token_.getType() != TokenType::period || token_.getType() != TokenType::lbrack)
 						{
 							shouldRepeat = false;
 						}
 					}
 					else {
 						shouldRepeat = false;
-						logger_->error(token_->getPosition(), "- SYNTAX ERROR; \"]\" is missing");
+						logger_->error(token_.getPosition(), "- SYNTAX ERROR; \"]\" is missing");
 					}
 				}
 				else {
-					logger_->error(token_->getPosition(), "- SEMANTIC ERROR; Array index must be number.");
+					logger_->error(token_.getPosition(), "- SEMANTIC ERROR; Array index must be number.");
 				}
 			}
 			else {
 				shouldRepeat = false;
-				logger_->error(token_->getPosition(), "- SEMANTIC ERROR; No valid expression.");
+				logger_->error(token_.getPosition(), "- SEMANTIC ERROR; No valid expression.");
 			}
 		}
 		else {
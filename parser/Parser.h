@@ -7,6 +7,7 @@
 
 
 #include "Scanner.h"
+#include "Arena.h"
 #include "ast/Node.h"
 
 #include "Variable.h"
@@ -17,7 +18,7 @@
 #include "Module.h"
 
 #include "Expression.h"
-#include "Factor.h"
+#include "ExpressionNode.h"
 
 #include "Type.h"
 #include "ArrayType.h"
@@ -38,37 +39,43 @@ class Parser
 private:
     Scanner *scanner_;
     Logger *logger_;
-    std::unique_ptr<const Token> token_;
+    Token token_;
     SymbolTable symbolTable_;
-    const std::string ident();
+    // owns the nodes of the AST that is being built, until it is handed over to the module
+    std::unique_ptr<Arena> arena_;
+    // the flat encoding of the expressions of the module, see ExpressionNode
+    std::vector<ExpressionNode> expressionNodes_;
+    const Ident integerIdent_, longintIdent_, charIdent_, booleanIdent_;
+    const Ident ident();
 
-    std::unique_ptr<const Module> module();
-    const std::vector<std::shared_ptr<const Variable>> declarations();
-    const std::vector<std::shared_ptr<const ConstVariable>> const_declarations();
-    const std::vector<std::shared_ptr<const TypeVariable>> type_declarations();
-    const std::vector<std::shared_ptr<const VarVariable>> var_declarations();
-    std::shared_ptr<const ProcedureVariable> procedure_declaration();
-    std::shared_ptr<const Expression> expression();
-    std::shared_ptr<const SimpleExpression> simple_expression();
-    std::shared_ptr<const Term> term();
-    std::shared_ptr<const Factor> factor();
-    std::shared_ptr<const Type> type();
-    std::shared_ptr<const ArrayType> array_type();
-    std::shared_ptr<const RecordType> record_type();
-    const std::vector<std::shared_ptr<const Variable>> field_list();
-    const std::vector<std::string> ident_list();
-    std::shared_ptr<const ProcedureHead> procedure_heading();
-    std::shared_ptr<const ProcedureBody> procedure_body(const std::string _procedureIdentifier);
-    const std::vector<std::shared_ptr<const Variable>> formal_parameters();
-    const std::vector<std::shared_ptr<const Variable>> fp_section();
-    const std::vector<std::shared_ptr<const Statement>> statement_sequence();
-    std::shared_ptr<const Statement> statement();
-    std::shared_ptr<const AssignmentStatement> assignment();
-    std::shared_ptr<const ProcedureCallStatement> procedure_call();
-    std::shared_ptr<const IfStatement> if_statement();
-    std::shared_ptr<const WhileStatement> while_statement();
-    const std::vector<std::shared_ptr<const Expression>> actual_parameters();
-    const std::shared_ptr<const Selector>  selector();
+    std::unique_ptr<Module> module();
+    const std::vector<const Variable*> declarations();
+    const std::vector<const ConstVariable*> const_declarations();
+    const std::vector<const TypeVariable*> type_declarations();
+    const std::vector<const VarVariable*> var_declarations();
+    const ProcedureVariable* procedure_declaration();
+    const Expression* expression();
+    uint32_t simple_expression();
+    uint32_t term();
+    uint32_t factor();
+    uint32_t emit(const ExpressionNode &node);
+    const Type* type();
+    const ArrayType* array_type();
+    const RecordType* record_type();
+    const std::vector<const Variable*> field_list();
+    const std::vector<Ident> ident_list();
+    const ProcedureHead* procedure_heading();
+    const ProcedureBody* procedure_body(const Ident _procedureIdentifier);
+    const std::vector<const Variable*> formal_parameters();
+    const std::vector<const Variable*> fp_section();
+    const std::vector<const Statement*> statement_sequence();
+    const Statement* statement();
+    const AssignmentStatement* assignment(const Variable* _variable, const Selector* _selector);
+    const ProcedureCallStatement* procedure_call(const Variable* _procedure);
+    const IfStatement* if_statement();
+    const WhileStatement* while_statement();
+    const std::vector<const Expression*> actual_parameters();
+    const Selector* selector();
 
 public:
     explicit Parser(Scanner *scanner, Logger *logger);
@@ -9,7 +9,7 @@
 
 class ProcedureCallStatement : public Statement {
 public:
-	explicit ProcedureCallStatement();
-	std::shared_ptr<const Variable> variable;
-	std::vector<std::shared_ptr<const Expression>> actualParameters;
+	explicit ProcedureCallStatement(const Variable* _variable);
+	const Variable* variable;
+	std::vector<const Expression*> actualParameters;
 };
\ No newline at end of file
@@ -7,22 +7,22 @@
 
 class ProcedureVariable : public Variable {
 public:
-	explicit ProcedureVariable(std::string _identifier);
-	std::vector<std::shared_ptr<const Variable>> parameters;
-	std::vector<std::shared_ptr<const Variable>> declarations;
-	std::vector<std::shared_ptr<const Statement>> statements;
+	explicit ProcedureVariable(Ident _identifier);
+	std::vector<const Variable*> parameters;
+	std::vector<const Variable*> declarations;
+	std::vector<const Statement*> statements;
 };
 
 class ProcedureHead {
 public:
-	explicit ProcedureHead(std::string _identifier);
-	const std::string identifier;
-	std::vector<std::shared_ptr<const Variable>> parameters;
+	explicit ProcedureHead(Ident _identifier);
+	const Ident identifier;
+	std::vector<const Variable*> parameters;
 };
 
 class ProcedureBody {
 public:
 	ProcedureBody();
-	std::vector<std::shared_ptr<const Variable>> declarations;
-	std::vector<std::shared_ptr<const Statement>> statements;
+	std::vector<const Variable*> declarations;
+	std::vector<const Statement*> statements;
 };
\ No newline at end of file
@@ -5,6 +5,6 @@
 
 class RecordSelector : public Selector {
 public:
-	explicit RecordSelector(std::shared_ptr<const Variable> _variable);
-	std::shared_ptr<const Variable> variable;
+	explicit RecordSelector(const Variable* _variable);
+	const Variable* variable;
 };
\ No newline at end of file
@@ -9,5 +9,5 @@
 class RecordType : public Type {
 public:
 	explicit RecordType();
-	std::vector<std::shared_ptr<const Variable>> fieldListNodes;
+	std::vector<const Variable*> fieldListNodes;
 };
\ No newline at end of file
@@ -1,10 +1,12 @@
 #include "Selector.h"
 #include "RecordSelector.h"
 
-ArraySelector::ArraySelector(std::shared_ptr<const Expression> _expression): expression(_expression) {
+Selector::Selector(NodeType _nodeType): Node(_nodeType) { }
+
+ArraySelector::ArraySelector(const Expression* _expression): Selector(NodeType::array_selector), expression(_expression) {
 	type = PrimitiveType::Array;
 }
 
-RecordSelector::RecordSelector(std::shared_ptr<const Variable> _variable) : variable(_variable) {
+RecordSelector::RecordSelector(const Variable* _variable) : Selector(NodeType::record_selector), variable(_variable) {
 	type = PrimitiveType::Record;
 }
\ No newline at end of file
@@ -5,15 +5,17 @@
 
 #include "Expression.h"
 #include "Type.h"
+#include "ast/Node.h"
 
-class Selector {
+class Selector : public Node {
 public:
+	explicit Selector(NodeType _nodeType);
 	PrimitiveType type;
-	std::map<int, std::shared_ptr<const Selector>> innerSelectors;
+	std::map<int, const Selector*> innerSelectors;
 };
 
 class ArraySelector: public Selector {
 public:
-	explicit ArraySelector(std::shared_ptr<const Expression> _expression);
-	std::shared_ptr<const Expression> expression;
+	explicit ArraySelector(const Expression* _expression);
+	const Expression* expression;
 };
\ No newline at end of file
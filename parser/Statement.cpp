@@ -4,14 +4,16 @@
 #include "IfStatement.h"
 #include "ProcedureCallStatement.h"
 
-AssignmentStatement::AssignmentStatement(std::shared_ptr<const Expression> _expression) : expression(_expression) { }
+Statement::Statement(NodeType _nodeType) : Node(_nodeType) { }
 
-ProcedureCallStatement::ProcedureCallStatement() {}
+AssignmentStatement::AssignmentStatement(const Variable* _variable, const Selector* _selector, const Expression* _expression) : Statement(NodeType::assignment_statement), variable(_variable), selector(_selector), expression(_expression) { }
 
-WhileStatement::WhileStatement(std::shared_ptr<const Expression> _expression) : expression(_expression) {}
+ProcedureCallStatement::ProcedureCallStatement(const Variable* _variable) : Statement(NodeType::procedure_call_statement), variable(_variable) {}
 
-IfStatement::IfStatement(std::shared_ptr<const Expression> _expression): expression(_expression) { }
+WhileStatement::WhileStatement(const Expression* _expression) : Statement(NodeType::while_statement), expression(_expression) {}
 
-ElseIf::ElseIf(std::shared_ptr<const Expression> _expression): expression(_expression) {}
+IfStatement::IfStatement(const Expression* _expression): Statement(NodeType::if_statement), expression(_expression), elseNode(nullptr) { }
 
-Else::Else() {}
\ No newline at end of file
+ElseIf::ElseIf(const Expression* _expression): Node(NodeType::else_if), expression(_expression) {}
+
+Else::Else() : Node(NodeType::else_branch) {}
\ No newline at end of file
@@ -1,3 +1,8 @@
 #pragma once
 
-class Statement { };
\ No newline at end of file
+#include "ast/Node.h"
+
+class Statement : public Node {
+public:
+	explicit Statement(NodeType _nodeType);
+};
\ No newline at end of file
@@ -1,10 +0,0 @@
-#pragma once
-
-#include "Factor.h"
-#include <string>
-
-class StringFactor : public Factor {
-public:
-	explicit StringFactor(const std::string _value);
-	const std::string value;
-};
\ No newline at end of file
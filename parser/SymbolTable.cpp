@@ -1,21 +1,60 @@
 #include "SymbolTable.h"
+#include "TimeReport.h"
 
 SymbolTable::SymbolTable() { }
 
 SymbolTable::~SymbolTable() = default;
 
+void SymbolTable::enterScope()
+{
+	scopes_.push_back(undo_.size());
+}
+
+void SymbolTable::exitScope()
+{
+	TIME_PHASE(symbol_table);
+	const size_t start = scopes_.back();
+	scopes_.pop_back();
+	while (undo_.size() > start)
+	{
+		const Shadowed &shadowed = undo_.back();
+		symbols_[shadowed.id] = shadowed.symbol;
+		undo_.pop_back();
+	}
+}
 
-void SymbolTable::insert(const std::string& name, std::shared_ptr<const Node> node)
+bool SymbolTable::insert(const Ident name, const Node* node)
 {
-	table_.insert({name, node});
+	TIME_PHASE(symbol_table);
+	COUNT_EVENT(symbol_inserts);
+	const unsigned int id = name.getId();
+	if (id >= symbols_.size())
+	{
+		symbols_.resize(id + 1, { nullptr, 0 });
+	}
+	Symbol &symbol = symbols_[id];
+	const unsigned int scope = (unsigned int) scopes_.size();
+	if (symbol.node != nullptr && symbol.scope == scope)
+	{
+		return false;
+	}
+	if (!scopes_.empty())
+	{
+		// declarations of the outermost scope are never undone
+		undo_.push_back({ id, symbol });
+	}
+	symbol = { node, scope };
+	return true;
 }
 
-std::shared_ptr<const Node> SymbolTable::lookup(const std::string& name) const
+const Node* SymbolTable::lookup(const Ident name) const
 {
-	auto element = table_.find(name);
-	if (element != table_.end())
+	TIME_PHASE(symbol_table);
+	COUNT_EVENT(symbol_lookups);
+	const unsigned int id = name.getId();
+	if (id < symbols_.size())
 	{
-		return element->second;
+		return symbols_[id].node;
 	}
 	return nullptr;
-}
\ No newline at end of file
+}
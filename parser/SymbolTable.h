@@ -1,19 +1,41 @@
 #pragma once
 
-#include <string>
-#include <unordered_map>
-#include <memory>
+#include <vector>
 #include "ast/Node.h"
+#include "Ident.h"
 
+/*
+ * The symbol table maps identifiers to the declarations that are visible in the current scope. As identifiers
+ * are interned, the table is indexed by their id, which makes lookups a single array access. Declaring a name
+ * that is already visible from an enclosing scope shadows it, and the shadowed declaration is saved on an undo
+ * stack, so that leaving a scope only restores the names that were declared in it.
+ */
 class SymbolTable
 {
 private:
-	std::unordered_map<std::string, std::shared_ptr<const Node>> table_;
+	struct Symbol {
+		const Node* node;
+		// the nesting depth of the scope that declared the symbol
+		unsigned int scope;
+	};
+
+	struct Shadowed {
+		unsigned int id;
+		Symbol symbol;
+	};
+
+	std::vector<Symbol> symbols_;
+	std::vector<Shadowed> undo_;
+	// the position of the undo stack at which each open scope started
+	std::vector<size_t> scopes_;
 
 public:
 	explicit SymbolTable();
 	~SymbolTable();
 
-	void insert(const std::string& name, std::shared_ptr<const Node> node);
-	std::shared_ptr<const Node> lookup(const std::string& name) const;
-};
\ No newline at end of file
+	void enterScope();
+	void exitScope();
+	// returns false and keeps the existing declaration if the name is already declared in the current scope
+	bool insert(const Ident name, const Node* node);
+	const Node* lookup(const Ident name) const;
+};
@@ -4,7 +4,7 @@
 
 Type::Type(PrimitiveType _primitiveType): primitiveType(_primitiveType), Node(NodeType::basic_type) { }
 
-ArrayType::ArrayType(std::shared_ptr<const Expression> _expression, std::shared_ptr<const Type> _type): Type(PrimitiveType::Array), expression(_expression), type(_type) { 
+ArrayType::ArrayType(const Expression* _expression, const Type* _type): Type(PrimitiveType::Array), expression(_expression), type(_type) { 
 	nodeType_ = NodeType::array_type;
 }
 
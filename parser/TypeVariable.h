@@ -4,6 +4,6 @@
 
 class TypeVariable : public Variable {
 public:
-	explicit TypeVariable(std::string _identifier, std::shared_ptr<const Type> _type);
-	std::shared_ptr<const Type> type;
+	explicit TypeVariable(Ident _identifier, const Type* _type);
+	const Type* type;
 };
@@ -4,6 +4,6 @@
 
 class VarVariable : public Variable {
 public:
-	explicit VarVariable(std::string _identifier, std::shared_ptr<const Type> _type);
-	std::shared_ptr<const Type> type;
+	explicit VarVariable(Ident _identifier, const Type* _type);
+	const Type* type;
 };
@@ -1,18 +1,17 @@
 #pragma once
 
-#include <string>
 #include <memory>
 
 #include "Type.h"
 #include "Selector.h"
 #include "ast/Node.h"
+#include "Ident.h"
 
 class Variable: public Node {
 public:
-	explicit Variable(std::string _identifier);
-	explicit Variable(std::string _identifier, std::shared_ptr<const Type> _type);
-	std::string identifier;
-	std::shared_ptr<const Type> type;
-	std::shared_ptr<const Selector> selector;
+	explicit Variable(Ident _identifier);
+	explicit Variable(Ident _identifier, const Type* _type);
+	Ident identifier;
+	const Type* type;
 	PrimitiveType primitiveType;
 };
\ No newline at end of file
@@ -8,7 +8,7 @@
 
 class WhileStatement : public Statement {
 public:
-	explicit WhileStatement(std::shared_ptr<const Expression> _expression);
-	std::shared_ptr<const Expression> expression;
-	std::vector<std::shared_ptr<const Statement>> statements;
+	explicit WhileStatement(const Expression* _expression);
+	const Expression* expression;
+	std::vector<const Statement*> statements;
 };
\ No newline at end of file
@@ -13,23 +13,33 @@
 #include <ostream>
 #include "Logger.h"
 
+/*
+ * The kind of a node, which is the concrete class of the node. Passes dispatch on the kind (see Visitor) instead
+ * of using RTTI, so that the nodes need no virtual functions. Expressions are not nodes, see ExpressionNode.
+ */
 enum class NodeType : char {
-	unary_expression,
-	binary_expression,
+	// declarations
+	module,
 	constant_reference,
-	boolean_constant,
-	number_constant,
-	string_constant,
 	type_reference,
-	record_type,
-	array_type,
-	basic_type,
-	field,
-	parameter,
-	variable,
 	variable_reference,
-	module,
-	procedure
+	// a field of a record, and the name of the field in a record selector
+	field,
+	procedure,
+	// types
+	basic_type,
+	array_type,
+	record_type,
+	// statements
+	assignment_statement,
+	procedure_call_statement,
+	if_statement,
+	else_if,
+	else_branch,
+	while_statement,
+	// selectors
+	array_selector,
+	record_selector
 };
 
 class Node {
@@ -0,0 +1,299 @@
+/*
+ * Header file of the visitor used to traverse the AST of the Oberon-0 compiler.
+ *
+ * A pass derives from Visitor and passes itself as the template argument, e.g.
+ * `class Checker : public Visitor<Checker>`, and hides the visit functions of the kinds of nodes that it is
+ * interested in. Visiting a node switches on its kind and calls the visit function of the pass for it, which is
+ * resolved at compile time, so the nodes need no virtual functions and there are no virtual calls to inline
+ * across. By default, a visit function visits the children of the node in the order of the source, so a pass
+ * that overrides a visit function has to call the one of Visitor to continue into the children.
+ *
+ * The declarations that statements refer to, such as the target of an assignment, are not children of them and are
+ * not visited again, but passed to visitReference. In an expression, a variable or a selection is an expression
+ * node, whose selector can be reached from the node; the index expressions of the selector are part of the
+ * expression and have been visited before it.
+ */
+
+#ifndef OBERON0C_VISITOR_H
+#define OBERON0C_VISITOR_H
+
+
+#include "ArrayType.h"
+#include "AssignmentStatement.h"
+#include "ConstVariable.h"
+#include "Expression.h"
+#include "IfStatement.h"
+#include "Module.h"
+#include "ProcedureCallStatement.h"
+#include "ProcedureVariable.h"
+#include "RecordSelector.h"
+#include "RecordType.h"
+#include "TypeVariable.h"
+#include "VarVariable.h"
+#include "WhileStatement.h"
+#include "ast/Node.h"
+
+template <typename Derived>
+class Visitor {
+
+private:
+	Derived &derived();
+
+protected:
+	// the flat expression nodes of the module that is visited, see Expression
+	const ExpressionNode *expressionNodes_;
+
+public:
+	explicit Visitor();
+
+	// visits a node of any kind; nodes may be null
+	void visit(const Node *node);
+	void visit(const Expression *expression);
+
+	void visitModule(const Module *node);
+	void visitConstVariable(const ConstVariable *node);
+	void visitTypeVariable(const TypeVariable *node);
+	void visitVarVariable(const VarVariable *node);
+	void visitField(const Variable *node);
+	void visitProcedureVariable(const ProcedureVariable *node);
+	void visitBasicType(const Type *node);
+	void visitArrayType(const ArrayType *node);
+	void visitRecordType(const RecordType *node);
+	void visitAssignmentStatement(const AssignmentStatement *node);
+	void visitProcedureCallStatement(const ProcedureCallStatement *node);
+	void visitIfStatement(const IfStatement *node);
+	void visitElseIf(const ElseIf *node);
+	void visitElse(const Else *node);
+	void visitWhileStatement(const WhileStatement *node);
+	void visitArraySelector(const ArraySelector *node);
+	void visitRecordSelector(const RecordSelector *node);
+	// the declaration that a statement refers to, e.g. the variable that is assigned or the procedure that is called
+	void visitReference(const Variable *node);
+	// visits the nodes of the expression in post-order
+	void visitExpression(const Expression *expression);
+	void visitExpressionNode(const ExpressionNode &node);
+
+};
+
+template <typename Derived>
+Visitor<Derived>::Visitor() : expressionNodes_(nullptr) {
+}
+
+template <typename Derived>
+Derived &Visitor<Derived>::derived() {
+	return *static_cast<Derived*>(this);
+}
+
+template <typename Derived>
+void Visitor<Derived>::visit(const Node *node) {
+	if (node == nullptr) {
+		return;
+	}
+	switch (node->nodeType_) {
+		case NodeType::module:
+			derived().visitModule(static_cast<const Module*>(node));
+			break;
+		case NodeType::constant_reference:
+			derived().visitConstVariable(static_cast<const ConstVariable*>(node));
+			break;
+		case NodeType::type_reference:
+			derived().visitTypeVariable(static_cast<const TypeVariable*>(node));
+			break;
+		case NodeType::variable_reference:
+			derived().visitVarVariable(static_cast<const VarVariable*>(node));
+			break;
+		case NodeType::field:
+			derived().visitField(static_cast<const Variable*>(node));
+			break;
+		case NodeType::procedure:
+			derived().visitProcedureVariable(static_cast<const ProcedureVariable*>(node));
+			break;
+		case NodeType::basic_type:
+			derived().visitBasicType(static_cast<const Type*>(node));
+			break;
+		case NodeType::array_type:
+			derived().visitArrayType(static_cast<const ArrayType*>(node));
+			break;
+		case NodeType::record_type:
+			derived().visitRecordType(static_cast<const RecordType*>(node));
+			break;
+		case NodeType::assignment_statement:
+			derived().visitAssignmentStatement(static_cast<const AssignmentStatement*>(node));
+			break;
+		case NodeType::procedure_call_statement:
+			derived().visitProcedureCallStatement(static_cast<const ProcedureCallStatement*>(node));
+			break;
+		case NodeType::if_statement:
+			derived().visitIfStatement(static_cast<const IfStatement*>(node));
+			break;
+		case NodeType::else_if:
+			derived().visitElseIf(static_cast<const ElseIf*>(node));
+			break;
+		case NodeType::else_branch:
+			derived().visitElse(static_cast<const Else*>(node));
+			break;
+		case NodeType::while_statement:
+			derived().visitWhileStatement(static_cast<const WhileStatement*>(node));
+			break;
+		case NodeType::array_selector:
+			derived().visitArraySelector(static_cast<const ArraySelector*>(node));
+			break;
+		case NodeType::record_selector:
+			derived().visitRecordSelector(static_cast<const RecordSelector*>(node));
+			break;
+	}
+}
+
+template <typename Derived>
+void Visitor<Derived>::visit(const Expression *expression) {
+	if (expression != nullptr) {
+		derived().visitExpression(expression);
+	}
+}
+
+template <typename Derived>
+void Visitor<Derived>::visitModule(const Module *node) {
+	expressionNodes_ = node->expressionNodes.data();
+	for (auto declaration : node->declarations) {
+		visit(declaration);
+	}
+	for (auto statement : node->statements) {
+		visit(statement);
+	}
+}
+
+template <typename Derived>
+void Visitor<Derived>::visitConstVariable(const ConstVariable *node) {
+	visit(node->expression);
+}
+
+template <typename Derived>
+void Visitor<Derived>::visitTypeVariable(const TypeVariable *node) {
+	visit(node->type);
+}
+
+template <typename Derived>
+void Visitor<Derived>::visitVarVariable(const VarVariable *node) {
+	visit(node->type);
+}
+
+template <typename Derived>
+void Visitor<Derived>::visitField(const Variable *node) {
+	visit(node->type);
+}
+
+template <typename Derived>
+void Visitor<Derived>::visitProcedureVariable(const ProcedureVariable *node) {
+	for (auto parameter : node->parameters) {
+		visit(parameter);
+	}
+	for (auto declaration : node->declarations) {
+		visit(declaration);
+	}
+	for (auto statement : node->statements) {
+		visit(statement);
+	}
+}
+
+template <typename Derived>
+void Visitor<Derived>::visitBasicType(const Type *) {
+}
+
+template <typename Derived>
+void Visitor<Derived>::visitArrayType(const ArrayType *node) {
+	visit(node->expression);
+	visit(node->type);
+}
+
+template <typename Derived>
+void Visitor<Derived>::visitRecordType(const RecordType *node) {
+	for (auto field : node->fieldListNodes) {
+		visit(field);
+	}
+}
+
+template <typename Derived>
+void Visitor<Derived>::visitAssignmentStatement(const AssignmentStatement *node) {
+	derived().visitReference(node->variable);
+	visit(node->selector);
+	visit(node->expression);
+}
+
+template <typename Derived>
+void Visitor<Derived>::visitProcedureCallStatement(const ProcedureCallStatement *node) {
+	derived().visitReference(node->variable);
+	for (auto parameter : node->actualParameters) {
+		visit(parameter);
+	}
+}
+
+template <typename Derived>
+void Visitor<Derived>::visitIfStatement(const IfStatement *node) {
+	visit(node->expression);
+	for (auto statement : node->statements) {
+		visit(statement);
+	}
+	for (auto elseIf : node->elseIfNodes) {
+		visit(elseIf);
+	}
+	visit(node->elseNode);
+}
+
+template <typename Derived>
+void Visitor<Derived>::visitElseIf(const ElseIf *node) {
+	visit(node->expression);
+	for (auto statement : node->statements) {
+		visit(statement);
+	}
+}
+
+template <typename Derived>
+void Visitor<Derived>::visitElse(const Else *node) {
+	for (auto statement : node->statements) {
+		visit(statement);
+	}
+}
+
+template <typename Derived>
+void Visitor<Derived>::visitWhileStatement(const WhileStatement *node) {
+	visit(node->expression);
+	for (auto statement : node->statements) {
+		visit(statement);
+	}
+}
+
+template <typename Derived>
+void Visitor<Derived>::visitArraySelector(const ArraySelector *node) {
+	visit(node->expression);
+	for (auto &inner : node->innerSelectors) {
+		visit(inner.second);
+	}
+}
+
+template <typename Derived>
+void Visitor<Derived>::visitRecordSelector(const RecordSelector *node) {
+	for (auto &inner : node->innerSelectors) {
+		visit(inner.second);
+	}
+}
+
+template <typename Derived>
+void Visitor<Derived>::visitReference(const Variable *) {
+}
+
+template <typename Derived>
+void Visitor<Derived>::visitExpression(const Expression *expression) {
+	if (expressionNodes_ == nullptr) {
+		return;
+	}
+	for (uint32_t i = expression->begin; i < expression->end; i++) {
+		derived().visitExpressionNode(expressionNodes_[i]);
+	}
+}
+
+template <typename Derived>
+void Visitor<Derived>::visitExpressionNode(const ExpressionNode &) {
+}
+
+
+#endif //OBERON0C_VISITOR_H
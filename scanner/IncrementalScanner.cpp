@@ -0,0 +1,80 @@
+/*
+ * Implementation of incremental re-scanning in the scanner used by the Oberon-0 compiler.
+ *
+ * The scanner keeps no state between tokens, and scanning a token looks at most one character past its
+ * end. Tokens that end before an edit are therefore not affected by it, and re-scanning starts at the
+ * end of the last of them. Beyond the edit, the old and the new source are the same text shifted by the
+ * length difference of the edit. As soon as the new scan starts a token at the shifted offset of an old
+ * token, it would produce the old tokens from there on, so these are reused. At the latest, the two
+ * scans agree on the end-of-input token.
+ *
+ * To avoid touching the reused tokens at all, the token stream is split at the most recent edit. The
+ * tokens after the split are kept in reverse order with offsets relative to the end of the source, which
+ * an edit before them does not change. An edit thus only moves the tokens between the previous and the
+ * current edit across the split, and only copies the source text once.
+ */
+
+#include <algorithm>
+#include "Scanner.h"
+
+void Scanner::moveSplit(const size_t offset) {
+    // the split is moved to the first token that looks at the character at the offset
+    const int size = (int) (end_ - begin_);
+    while (!scanned_.empty() && scanned_.back().getOffset() + scanned_.back().getLength() >= offset) {
+        tail_.push_back(scanned_.back().shifted(-size));
+        scanned_.pop_back();
+    }
+    while (!tail_.empty()) {
+        const Token token = tail_.back().shifted(size);
+        if (token.getOffset() + token.getLength() >= offset) {
+            break;
+        }
+        scanned_.push_back(token);
+        tail_.pop_back();
+    }
+}
+
+const TokenRange Scanner::edit(const TextEdit &edit) {
+    if (!complete_) {
+        scanAll();
+    }
+    if (text_.data() != begin_) {
+        // the source is copied once, so that it can be edited in place from now on
+        text_.assign(begin_, end_);
+    }
+    const size_t offset = std::min((size_t) edit.offset, text_.size());
+    const size_t removed = std::min((size_t) edit.removed, text_.size() - offset);
+    const size_t inserted = edit.inserted.size();
+    moveSplit(offset);
+    const size_t first = scanned_.size();
+    size_t replaced = 0;
+    // tokens that start before the end of the removed text cannot be reused
+    while (!tail_.empty() && tail_.back().shifted((int) text_.size()).getOffset() < offset + removed) {
+        tail_.pop_back();
+        replaced++;
+    }
+    text_.replace(offset, removed, edit.inserted);
+    begin_ = text_.data();
+    end_ = begin_ + text_.size();
+    FileTable::instance().update(fileId_, begin_, text_.size());
+
+    cur_ = begin_ + ((first == 0) ? 0 : scanned_.back().getOffset() + scanned_.back().getLength());
+    ch_ = (cur_ < end_) ? *cur_ : (char) -1;
+    const int size = (int) text_.size();
+    while (true) {
+        const Token token = (engine_ == ScanEngine::table) ? this->nextTable() : this->next();
+        if (token.getOffset() >= offset + inserted) {
+            // the old tokens after the split are compared at their offsets shifted by the edit
+            while (!tail_.empty() && tail_.back().shifted(size).getOffset() < token.getOffset()) {
+                tail_.pop_back();
+                replaced++;
+            }
+            if (!tail_.empty() && tail_.back().shifted(size).getOffset() == token.getOffset()) {
+                break;
+            }
+        }
+        scanned_.push_back(token);
+    }
+    rewind();
+    return { first, replaced, scanned_.size() - first };
+}
@@ -0,0 +1,301 @@
+/*
+ * Implementation of the parallel mode of the scanner used by the Oberon-0 compiler.
+ *
+ * The source buffer is split into chunks that start at the beginning of a line, and every chunk is
+ * scanned speculatively on its own thread, as if a token started at the beginning of the chunk. This
+ * guess is wrong if the chunk starts inside a comment, a string or a token. However, the scanner keeps
+ * no state between tokens, so two scans that start a token at the same offset produce the same tokens
+ * from there on. The chunks are stitched together in order by looking up the first token that the scan
+ * of the previous chunk started beyond its end. If the speculative scan never started a token at that
+ * offset, the chunk is rescanned from there until both scans agree on a token again.
+ *
+ * Identifiers are interned into a table per chunk and remapped to the global identifier table while
+ * stitching, and errors are deferred until it is known whether the token that raised them is kept. The
+ * token stream, the identifier ids and the errors are thus identical to those of a sequential scan.
+ *
+ * Stitching itself only decides which tokens of every chunk are kept, reports their errors and interns
+ * the identifiers that they introduce, which every chunk records in the order of their first occurrence.
+ * Afterwards, the kept tokens are remapped and copied into the token stream by one thread per segment,
+ * into memory that was allocated while the chunks were scanned. The number of chunks is capped at the
+ * number of cores, as more threads than cores only add the cost of stitching to that of a sequential scan.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include "Scanner.h"
+#include "../util/Trace.h"
+
+struct ScanDiagnostic {
+    size_t token;
+    FilePos pos;
+    std::string msg;
+};
+
+struct ScanChunk {
+    // offset of the first character that belongs to the next chunk
+    size_t limit;
+    // tokens starting before the limit, followed by the first token starting at or after it
+    std::vector<Token> tokens;
+    std::vector<ScanDiagnostic> diagnostics;
+    IdentTable idents;
+    // index of the token at which every identifier of the chunk first occurs, in the order of the ids
+    std::vector<size_t> firstTokens;
+    std::vector<unsigned int> globalIds;
+};
+
+// tokens [from, to) of a chunk that are part of the token stream
+struct ScanSegment {
+    const ScanChunk *chunk;
+    size_t from, to;
+    // position of the first token in the token stream
+    size_t offset;
+};
+
+// below this size per chunk, starting a thread costs more than it saves
+static const size_t MIN_CHUNK_SIZE = 256 * 1024;
+
+static const size_t NOT_SYNCED = (size_t) -1;
+
+static bool startsBefore(const Token &token, const size_t offset) {
+    return token.getOffset() < offset;
+}
+
+Scanner::Scanner(const Scanner &parent, ScanChunk *chunk, const char *start) :
+        filename_(parent.filename_), logger_(parent.logger_), engine_(parent.engine_), head_(0), count_(0),
+        eof_(false), fileId_(parent.fileId_), base_(0), keep_(0), threads_(1), scannedNext_(0), complete_(false),
+        chunk_(chunk), idents_(&chunk->idents), errors_(0) {
+    begin_ = parent.begin_;
+    cur_ = start;
+    end_ = parent.end_;
+    mark_ = cur_;
+    ch_ = (cur_ < end_) ? *cur_ : (char) -1;
+}
+
+void Scanner::error(const FilePos pos, const std::string &msg) {
+    if (chunk_ == nullptr) {
+        errors_++;
+        logger_->error(pos, msg);
+    } else {
+        // the error belongs to the token that is being scanned, which is not yet part of the chunk
+        chunk_->diagnostics.push_back({ chunk_->tokens.size(), pos, msg });
+    }
+}
+
+size_t Scanner::scanChunk(const std::vector<Token> *speculative) {
+    TRACE_SCOPE((speculative == nullptr) ? "scan chunk" : "rescan chunk");
+    size_t synced = NOT_SYNCED;
+    size_t index = 0;
+    if (speculative == nullptr && chunk_->limit > (size_t) (cur_ - begin_)) {
+        // typical sources have a token every four to five characters
+        chunk_->tokens.reserve((chunk_->limit - (size_t) (cur_ - begin_)) / 4);
+    }
+    while (true) {
+        const Token token = (engine_ == ScanEngine::table) ? this->nextTable() : this->next();
+        chunk_->tokens.push_back(token);
+        if (token.getType() == TokenType::const_ident && (size_t) token.getValue() > chunk_->firstTokens.size()) {
+            // identifiers are numbered in the order in which they are interned
+            chunk_->firstTokens.push_back(chunk_->tokens.size() - 1);
+        }
+        if (token.getType() == TokenType::eof || token.getOffset() >= chunk_->limit) {
+            break;
+        }
+        if (speculative != nullptr) {
+            while (index < speculative->size() && (*speculative)[index].getOffset() < token.getOffset()) {
+                index++;
+            }
+            if (index < speculative->size() && (*speculative)[index].getOffset() == token.getOffset()) {
+                synced = index;
+                break;
+            }
+        }
+    }
+    chunk_->globalIds.assign(chunk_->idents.size() + 1, Ident::NONE);
+    return synced;
+}
+
+void Scanner::accept(ScanChunk &chunk, const size_t from, const size_t to, const size_t start,
+                     std::vector<ScanSegment> &segments) {
+    if (from >= to) {
+        return;
+    }
+    auto diagnostic = std::lower_bound(chunk.diagnostics.begin(), chunk.diagnostics.end(), from,
+                                       [](const ScanDiagnostic &d, const size_t token) { return d.token < token; });
+    for (; diagnostic != chunk.diagnostics.end() && diagnostic->token < to; ++diagnostic) {
+        // errors raised while skipping to the first token are only valid if the skip started on a token boundary
+        if (diagnostic->token != from || diagnostic->pos.offset >= start) {
+            error(diagnostic->pos, diagnostic->msg);
+        }
+    }
+
+    // the identifiers that first occur in the segment are interned in the order in which a sequential scan
+    // would; an identifier that already occurred before the segment is only looked for in the segment if
+    // it has not been interned yet
+    std::vector<std::pair<size_t, unsigned int>> firsts;
+    std::vector<bool> missing(chunk.firstTokens.size() + 1, false);
+    size_t missingCount = 0;
+    for (unsigned int id = 1; id <= chunk.firstTokens.size(); id++) {
+        const size_t first = chunk.firstTokens[id - 1];
+        if (first >= to || chunk.globalIds[id] != Ident::NONE) {
+            continue;
+        }
+        if (first >= from) {
+            firsts.emplace_back(first, id);
+        } else {
+            missing[id] = true;
+            missingCount++;
+        }
+    }
+    for (size_t i = from; i < to && missingCount > 0; i++) {
+        const Token &token = chunk.tokens[i];
+        if (token.getType() == TokenType::const_ident && missing[(size_t) token.getValue()]) {
+            missing[(size_t) token.getValue()] = false;
+            missingCount--;
+            firsts.emplace_back(i, (unsigned int) token.getValue());
+        }
+    }
+    std::sort(firsts.begin(), firsts.end());
+    for (auto &first : firsts) {
+        chunk.globalIds[first.second] = IdentTable::instance().intern(chunk.idents.getName(Ident(first.second))).getId();
+    }
+    const size_t offset = segments.empty() ? 0 : segments.back().offset + (segments.back().to - segments.back().from);
+    segments.push_back({ &chunk, from, to, offset });
+}
+
+// copies the tokens of a segment to the token stream and maps their identifiers to the global ones
+static void emit(const ScanSegment &segment, Token *out) {
+    TRACE_SCOPE("emit segment");
+    const ScanChunk &chunk = *segment.chunk;
+    for (size_t i = segment.from; i < segment.to; i++) {
+        const Token &token = chunk.tokens[i];
+        if (token.getType() == TokenType::const_ident) {
+            *out++ = Token(token.getType(), token.getPosition(), token.getLength(),
+                           (int) chunk.globalIds[(size_t) token.getValue()]);
+        } else {
+            *out++ = token;
+        }
+    }
+}
+
+void Scanner::scanParallel() {
+    if (!source_.isComplete()) {
+        // streamed sources are scanned sequentially, as they are never in memory as a whole
+        threads_ = 1;
+        return;
+    }
+    const size_t size = (size_t) (end_ - begin_);
+    size_t count = std::min((size_t) threads_, size / MIN_CHUNK_SIZE);
+    const unsigned int cores = std::thread::hardware_concurrency();
+    if (cores > 0) {
+        count = std::min(count, (size_t) cores);
+    }
+    if (count < 2) {
+        threads_ = 1;
+        return;
+    }
+    std::vector<size_t> starts;
+    starts.push_back((size_t) (cur_ - begin_));
+    for (size_t i = 1; i < count; i++) {
+        const size_t offset = (i * size) / count;
+        const char *line = static_cast<const char*>(memchr(begin_ + offset, '\n', size - offset));
+        if (line != nullptr && (size_t) (line + 1 - begin_) > starts.back() && line + 1 < end_) {
+            starts.push_back((size_t) (line + 1 - begin_));
+        }
+    }
+    std::vector<std::unique_ptr<ScanChunk>> chunks;
+    for (size_t i = 0; i < starts.size(); i++) {
+        chunks.emplace_back(new ScanChunk());
+        chunks.back()->limit = (i + 1 < starts.size()) ? starts[i + 1] : size + 1;
+    }
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < chunks.size(); i++) {
+        workers.emplace_back([this, &chunks, &starts, i]() {
+            Scanner(*this, chunks[i].get(), begin_ + starts[i]).scanChunk(nullptr);
+        });
+    }
+    // touching the memory of the token stream for the first time costs about as much as scanning a chunk, so it
+    // is allocated while the chunks are scanned; there are about a quarter as many tokens as characters in
+    // typical sources, and up to a third fit without moving the tokens once their number is known
+    std::vector<Token> stream;
+    std::thread allocator([&stream, size]() {
+        stream.reserve(size / 3);
+        stream.resize(size / 4);
+    });
+    Scanner(*this, chunks[0].get(), cur_).scanChunk(nullptr);
+
+    std::vector<ScanSegment> segments;
+    // chunks that were rescanned, whose tokens are kept until they are copied
+    std::vector<std::unique_ptr<ScanChunk>> repairs;
+    // offset of the first token of the sequential scan that has not been stitched yet
+    size_t next = 0;
+    for (size_t i = 0; i < chunks.size(); i++) {
+        if (i > 0) {
+            workers[i - 1].join();
+        }
+        ScanChunk &chunk = *chunks[i];
+        ScanChunk *last = &chunk;
+        if (i == 0) {
+            accept(chunk, 0, chunk.tokens.size() - 1, 0, segments);
+        } else if (next < chunk.limit) {
+            const auto first = std::lower_bound(chunk.tokens.begin(), chunk.tokens.end(), next, startsBefore);
+            if (first != chunk.tokens.end() && first->getOffset() == next) {
+                accept(chunk, (size_t) (first - chunk.tokens.begin()), chunk.tokens.size() - 1, next, segments);
+            } else {
+                // the speculative scan went astray, so rescan until both scans start a token at the same offset
+                repairs.emplace_back(new ScanChunk());
+                ScanChunk &repair = *repairs.back();
+                repair.limit = chunk.limit;
+                const size_t synced = Scanner(*this, &repair, begin_ + next).scanChunk(&chunk.tokens);
+                if (synced == NOT_SYNCED) {
+                    accept(repair, 0, repair.tokens.size() - 1, 0, segments);
+                    last = &repair;
+                } else {
+                    accept(repair, 0, repair.tokens.size(), 0, segments);
+                    accept(chunk, synced + 1, chunk.tokens.size() - 1, 0, segments);
+                }
+            }
+        } else {
+            // a token or comment of a previous chunk extends over this chunk
+            continue;
+        }
+        const Token &overflow = last->tokens.back();
+        if (overflow.getOffset() < last->limit) {
+            // the end-of-input token of the last chunk
+            accept(*last, last->tokens.size() - 1, last->tokens.size(), 0, segments);
+            break;
+        }
+        // errors raised while skipping to the first token of a following chunk are reported now
+        const size_t index = last->tokens.size() - 1;
+        for (auto &diagnostic : last->diagnostics) {
+            if (diagnostic.token == index && diagnostic.pos.offset < overflow.getOffset()) {
+                error(diagnostic.pos, diagnostic.msg);
+            }
+        }
+        next = overflow.getOffset();
+    }
+
+    const size_t total = segments.empty() ? 0 : segments.back().offset + (segments.back().to - segments.back().from);
+    allocator.join();
+    stream.resize(total);
+    std::vector<std::thread> emitters;
+    for (size_t i = 1; i < segments.size(); i++) {
+        emitters.emplace_back([&segments, &stream, i]() { emit(segments[i], stream.data() + segments[i].offset); });
+    }
+    if (!segments.empty()) {
+        emit(segments[0], stream.data());
+    }
+    for (auto &emitter : emitters) {
+        emitter.join();
+    }
+    if (scanned_.empty()) {
+        scanned_.swap(stream);
+    } else {
+        scanned_.insert(scanned_.end(), stream.begin(), stream.end());
+    }
+    for (size_t i = 0; i < workers.size(); i++) {
+        if (workers[i].joinable()) {
+            workers[i].join();
+        }
+    }
+    complete_ = true;
+}
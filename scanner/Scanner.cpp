@@ -5,206 +5,443 @@
  */
 
 
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstring>
 #include "Scanner.h"
-#include "IdentToken.h"
-#include "NumberToken.h"
-#include "StringToken.h"
+#include "SourceSkipper.h"
+#include "../util/TimeReport.h"
+#include "../util/Trace.h"
+
+/*
+ * Keywords are recognized with a perfect hash over the first two characters and the length of an
+ * identifier, which is computed and checked for collisions at compile time. Identifiers can thus be
+ * classified directly on the source buffer, with one table probe and at most one memcmp.
+ */
+struct Keyword {
+    const char *text;
+    TokenType type;
+};
+
+static constexpr Keyword KEYWORDS[] = {
+        { "DIV", TokenType::op_div }, { "MOD", TokenType::op_mod }, { "OR", TokenType::op_or },
+        { "MODULE", TokenType::kw_module }, { "PROCEDURE", TokenType::kw_procedure },
+        { "BEGIN", TokenType::kw_begin }, { "END", TokenType::kw_end },
+        { "WHILE", TokenType::kw_while }, { "DO", TokenType::kw_do},
+        { "IF", TokenType::kw_if }, { "THEN", TokenType::kw_then },
+        { "ELSE", TokenType::kw_else }, { "ELSIF", TokenType::kw_elsif },
+        { "VAR", TokenType::kw_var }, { "CONST", TokenType::kw_const },
+        { "TYPE", TokenType::kw_type }, { "ARRAY", TokenType::kw_array },
+        { "RECORD", TokenType::kw_record }, { "OF", TokenType::kw_of },
+        { "TRUE", TokenType::const_true }, { "FALSE", TokenType::const_false } };
+
+static constexpr size_t KEYWORD_COUNT = sizeof(KEYWORDS) / sizeof(KEYWORDS[0]);
+static constexpr size_t KEYWORD_MIN_LENGTH = 2;
+static constexpr size_t KEYWORD_MAX_LENGTH = 9;
+static constexpr unsigned int KEYWORD_HASH_SIZE = 32;
+
+static constexpr unsigned int keywordHash(const char first, const char second, const size_t length) {
+    return ((unsigned char) first * 17u + (unsigned char) second * 7u + (unsigned int) length) & (KEYWORD_HASH_SIZE - 1);
+}
+
+static constexpr size_t keywordLength(const char *text) {
+    size_t length = 0;
+    while (text[length] != '\0') {
+        length++;
+    }
+    return length;
+}
+
+struct KeywordTable {
+    signed char index[KEYWORD_HASH_SIZE];
+    unsigned char length[KEYWORD_COUNT];
+    bool perfect;
+};
+
+static constexpr KeywordTable buildKeywordTable() {
+    KeywordTable table {};
+    table.perfect = true;
+    for (unsigned int i = 0; i < KEYWORD_HASH_SIZE; i++) {
+        table.index[i] = -1;
+    }
+    for (size_t i = 0; i < KEYWORD_COUNT; i++) {
+        const size_t length = keywordLength(KEYWORDS[i].text);
+        const unsigned int hash = keywordHash(KEYWORDS[i].text[0], KEYWORDS[i].text[1], length);
+        table.perfect = table.perfect && (table.index[hash] == -1) &&
+                        (length >= KEYWORD_MIN_LENGTH) && (length <= KEYWORD_MAX_LENGTH);
+        table.index[hash] = (signed char) i;
+        table.length[i] = (unsigned char) length;
+    }
+    return table;
+}
+
+static constexpr KeywordTable KEYWORD_TABLE = buildKeywordTable();
+static_assert(KEYWORD_TABLE.perfect, "keyword hash is not perfect, adjust the hash function");
+
+const TokenType Scanner::keyword(const char *start, const size_t length) {
+    if ((length < KEYWORD_MIN_LENGTH) || (length > KEYWORD_MAX_LENGTH)) {
+        return TokenType::const_ident;
+    }
+    const int i = KEYWORD_TABLE.index[keywordHash(start[0], start[1], length)];
+    if ((i >= 0) && (KEYWORD_TABLE.length[i] == length) && (memcmp(KEYWORDS[i].text, start, length) == 0)) {
+        return KEYWORDS[i].type;
+    }
+    return TokenType::const_ident;
+}
+
+/*
+ * Number literals are scanned in two steps. First, the run of digits and hexadecimal letters is found,
+ * and then it is converted as a whole, so that the range of the value is checked only once per literal.
+ * Decimal digits are converted eight at a time within a 64-bit word (SWAR), which takes three multiplications
+ * instead of eight.
+ */
+static constexpr size_t MAX_DECIMAL_DIGITS = 10;
+static constexpr size_t MAX_HEX_DIGITS = 8;
+
+static inline bool isHexDigit(const char c) {
+    return ((c >= '0') && (c <= '9')) || ((c >= 'A') && (c <= 'F'));
+}
+
+static inline uint64_t parseEightDigits(const char *digits) {
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    // the first digit is in the lowest byte: combine pairs of digits, then pairs of pairs, and so on
+    uint64_t word;
+    memcpy(&word, digits, sizeof(word));
+    word = (word & 0x0F0F0F0F0F0F0F0FULL) * 2561 >> 8;
+    word = (word & 0x00FF00FF00FF00FFULL) * 6553601 >> 16;
+    return (word & 0x0000FFFF0000FFFFULL) * 42949672960001ULL >> 32;
+#else
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) {
+        value = 10 * value + (uint64_t) (digits[i] - '0');
+    }
+    return value;
+#endif
+}
+
+const size_t Scanner::TOKEN_BUFFER_SIZE;
 
 Scanner::Scanner(const std::string &filename, const Logger *logger) :
-        filename_(filename), logger_(logger), token_(nullptr), lineNo_(1), charNo_(0) {
-    this->initTable();
-    file_.open(filename_, std::ios::in);
-    if (!file_.is_open()) {
+        filename_(filename), logger_(logger), engine_(ScanEngine::direct), head_(0), count_(0), eof_(false),
+        fileId_(FileTable::NO_FILE), base_(0), keep_(0), threads_(1), scannedNext_(0), complete_(false),
+        chunk_(nullptr), idents_(&IdentTable::instance()), errors_(0) {
+    TIME_PHASE(scanner_setup);
+    if (!source_.open(filename_)) {
         // TODO I/O Exception
         logger_->error(filename_, "Cannot open file.");
         exit(1);
     }
-    read();
+    fileId_ = FileTable::instance().add(filename_, source_.begin(), source_.size());
+    init();
+}
+
+Scanner::Scanner(const std::string &name, const char *data, size_t size, const Logger *logger) :
+        filename_(name), logger_(logger), engine_(ScanEngine::direct), head_(0), count_(0), eof_(false),
+        fileId_(FileTable::NO_FILE), base_(0), keep_(0), threads_(1), scannedNext_(0), complete_(false),
+        chunk_(nullptr), idents_(&IdentTable::instance()), errors_(0) {
+    TIME_PHASE(scanner_setup);
+    // the data is scanned in place and has to outlive the scanner
+    source_.assign(data, size);
+    fileId_ = FileTable::instance().add(filename_, source_.begin(), source_.size());
+    init();
+}
+
+Scanner::Scanner(const std::string &name, std::istream &stream, const Logger *logger) :
+        filename_(name), logger_(logger), engine_(ScanEngine::direct), head_(0), count_(0), eof_(false),
+        fileId_(FileTable::NO_FILE), base_(0), keep_(0), threads_(1), scannedNext_(0), complete_(false),
+        chunk_(nullptr), idents_(&IdentTable::instance()), errors_(0) {
+    TIME_PHASE(scanner_setup);
+    // the text of a streamed source is not kept, so its line table is built while it is read
+    source_.stream(&stream);
+    fileId_ = FileTable::instance().add(filename_, nullptr, 0);
+    init();
+    refill();
+    ch_ = (cur_ < end_) ? *cur_ : (char) -1;
+}
+
+void Scanner::init() {
+    begin_ = source_.begin();
+    cur_ = begin_;
+    end_ = source_.end();
+    mark_ = begin_;
+    ch_ = (cur_ < end_) ? *cur_ : (char) -1;
 }
 
 Scanner::~Scanner() {
-    if (token_) {
-        delete token_;
+    if (chunk_ == nullptr) {
+        FileTable::instance().release(fileId_);
+    }
+}
+
+const Token& Scanner::peekToken(size_t lookahead) {
+    if (lookahead >= TOKEN_BUFFER_SIZE) {
+        lookahead = TOKEN_BUFFER_SIZE - 1;
+    }
+    while (count_ <= lookahead) {
+        fill();
+    }
+    return tokens_[(head_ + lookahead) & (TOKEN_BUFFER_SIZE - 1)];
+}
+
+const Token Scanner::nextToken() {
+    if (count_ == 0) {
+        fill();
+    }
+    const Token token = tokens_[head_];
+    head_ = (head_ + 1) & (TOKEN_BUFFER_SIZE - 1);
+    count_--;
+    COUNT_EVENT(tokens);
+    keep_ = token.getOffset();
+    return token;
+}
+
+void Scanner::fill() {
+    TIME_PHASE(scanning);
+    TRACE_SCOPE("scan");
+    // tokens are scanned in batches to keep the scanner loop hot, but never beyond the end of input
+    if (!complete_ && scannedNext_ == 0) {
+        if (!cacheDir_.empty()) {
+            scanCached();
+        } else if (threads_ > 1) {
+            scanParallel();
+        }
     }
-    if (file_.is_open()) {
-        file_.close();
+    if (eof_) {
+        // the most recently scanned token is the end-of-input token, which is repeated from now on
+        tokens_[(head_ + count_) & (TOKEN_BUFFER_SIZE - 1)] = tokens_[(head_ + count_ - 1) & (TOKEN_BUFFER_SIZE - 1)];
+        count_++;
+        return;
     }
+    while (count_ < TOKEN_BUFFER_SIZE) {
+        Token &token = tokens_[(head_ + count_) & (TOKEN_BUFFER_SIZE - 1)];
+        if (complete_) {
+            if (scannedNext_ < scanned_.size()) {
+                token = scanned_[scannedNext_];
+            } else {
+                token = tail_[tail_.size() - 1 - (scannedNext_ - scanned_.size())].shifted((int) (end_ - begin_));
+            }
+            scannedNext_++;
+        } else {
+            token = (engine_ == ScanEngine::table) ? this->nextTable() : this->next();
+            scannedNext_++;
+        }
+        count_++;
+        if (token.getType() == TokenType::eof) {
+            eof_ = true;
+            break;
+        }
+    }
+}
+
+void Scanner::setEngine(ScanEngine engine) {
+    engine_ = engine;
+}
+
+const ScanEngine Scanner::getEngine() const {
+    return engine_;
+}
+
+void Scanner::setThreads(unsigned int threads) {
+    // only takes effect before the first token is requested
+    threads_ = (threads == 0) ? 1 : threads;
+}
+
+const unsigned int Scanner::getThreads() const {
+    return threads_;
+}
+
+void Scanner::setCacheDirectory(const std::string &directory) {
+    // only takes effect before the first token is requested
+    cacheDir_ = directory;
 }
 
-void Scanner::initTable() {
-    keywords_ = { { "DIV", TokenType::op_div }, { "MOD", TokenType::op_mod }, { "OR", TokenType::op_or },
-                  { "MODULE", TokenType::kw_module }, { "PROCEDURE", TokenType::kw_procedure },
-                  { "BEGIN", TokenType::kw_begin }, { "END", TokenType::kw_end },
-                  { "WHILE", TokenType::kw_while }, { "DO", TokenType::kw_do},
-                  { "IF", TokenType::kw_if }, { "THEN", TokenType::kw_then },
-                  { "ELSE", TokenType::kw_else }, { "ELSIF", TokenType::kw_elsif },
-                  { "VAR", TokenType::kw_var }, { "CONST", TokenType::kw_const },
-                  { "TYPE", TokenType::kw_type }, { "ARRAY", TokenType::kw_array },
-                  { "RECORD", TokenType::kw_record }, { "OF", TokenType::kw_of },
-                  { "TRUE", TokenType::const_true }, { "FALSE", TokenType::const_false } };
+const std::string Scanner::getCacheDirectory() const {
+    return cacheDir_;
 }
 
-const Token* Scanner::peekToken() {
-    if (token_ == nullptr) {
-        token_ = this->next();
+void Scanner::scanAll() {
+    if (!source_.isComplete()) {
+        if (base_ > 0) {
+            logger_->error(filename_, "Cannot rescan a streamed source.");
+            exit(1);
+        }
+        // the rest of the stream is read, so that the complete source is in memory
+        cur_ = begin_;
+        mark_ = begin_;
+        keep_ = 0;
+        while (refill()) {
+        }
+    }
+    // the source is scanned from its beginning, but tokens that have already been handed out are not repeated
+    cur_ = begin_;
+    ch_ = (cur_ < end_) ? *cur_ : (char) -1;
+    if (threads_ > 1) {
+        scanParallel();
+    }
+    if (!complete_) {
+        scanned_.clear();
+        do {
+            scanned_.push_back((engine_ == ScanEngine::table) ? this->nextTable() : this->next());
+        } while (scanned_.back().getType() != TokenType::eof);
+        complete_ = true;
     }
-    return token_;
 }
 
-std::unique_ptr<const Token> Scanner::nextToken() {
-    const Token *token;
-    if (token_ != nullptr) {
-        token = token_;
-        token_ = nullptr;
-    } else {
-        token = this->next();
+const std::vector<Token>& Scanner::getTokens() {
+    if (!complete_) {
+        scanAll();
     }
-    return std::unique_ptr<const Token>(token);
+    while (!tail_.empty()) {
+        scanned_.push_back(tail_.back().shifted((int) (end_ - begin_)));
+        tail_.pop_back();
+    }
+    return scanned_;
 }
 
-const Token* Scanner::next() {
-    const Token *token;
-    // Skip whitespace
-    while ((ch_ != -1) && (ch_ <= ' ')) {
-        read();
+void Scanner::rewind() {
+    if (!complete_) {
+        scanAll();
+    }
+    head_ = 0;
+    count_ = 0;
+    eof_ = false;
+    scannedNext_ = 0;
+}
+
+const std::string Scanner::getText(const Token &token) const {
+    if (token.getOffset() < base_) {
+        // the text of a streamed source is only kept from the token that was handed out last
+        return std::string();
     }
-    if (ch_ != -1) {
-        FilePos pos = getPosition();
+    return std::string(begin_ + (token.getOffset() - base_), token.getLength());
+}
+
+const Token Scanner::next() {
+    TokenType type;
+    int value = 0;
+    while (true) {
+        // Skip whitespace
+        while ((ch_ != -1) && (ch_ <= ' ')) {
+            mark_ = cur_;
+            skipTo(SourceSkipper::whitespace(cur_ + 1, end_));
+        }
+        mark_ = cur_;
+        if (ch_ == -1) {
+            type = TokenType::eof;
+            break;
+        }
         if (((ch_ >= 'A') && (ch_ <= 'Z')) || ((ch_ >= 'a') && (ch_ <= 'z'))) {
             // Scan identifier
-            token = ident();
-        } else if ((ch_ >= '0') && (ch_ <= '9')) {
+            type = ident();
+            if (type == TokenType::const_ident) {
+                value = (int) idents_->intern(mark_, (size_t) (cur_ - mark_)).getId();
+            }
+            break;
+        }
+        if ((ch_ >= '0') && (ch_ <= '9')) {
             // Scan number
-            token = new NumberToken(pos, number());
-        } else {
-            switch (ch_) {
-                case '&':
-                    token = new Token(TokenType::op_and, pos);
-                    read();
-                    break;
-                case '*':
-                    token = new Token(TokenType::op_times, pos);
-                    read();
-                    break;
-                case '+':
-                    token = new Token(TokenType::op_plus, pos);
-                    read();
-                    break;
-                case '-':
-                    token = new Token(TokenType::op_minus, pos);
-                    read();
-                    break;
-                case '=':
-                    token = new Token(TokenType::op_eq, pos);
-                    read();
-                    break;
-                case '#':
-                    token = new Token(TokenType::op_neq, pos);
-                    read();
-                    break;
-                case '<':
-                    read();
-                    if (ch_ == '=') {
-                        token = new Token(TokenType::op_leq, pos);
-                        read();
-                    } else {
-                        token = new Token(TokenType::op_lt, pos);
-                    }
-                    break;
-                case '>':
-                    read();
-                    if (ch_ == '=') {
-                        token = new Token(TokenType::op_geq, pos);
-                        read();
-                    } else {
-                        token = new Token(TokenType::op_gt, pos);
-                    }
-                    break;
-                case ';':
-                    token = new Token(TokenType::semicolon, pos);
-                    read();
-                    break;
-                case ',':
-                    token = new Token(TokenType::comma, pos);
-                    read();
-                    break;
-                case ':':
-                    read();
-                    if (ch_ == '=') {
-                        token = new Token(TokenType::op_becomes, pos);
-                        read();
-                    } else {
-                        token = new Token(TokenType::colon, pos);
-                    }
-                    break;
-                case '.':
-                    token = new Token(TokenType::period, pos);
-                    read();
-                    break;
-                case '(':
-                    read();
-                    if (ch_ == '*') {
-                        comment();
-                        token = next();
-                    } else {
-                        token = new Token(TokenType::lparen, pos);
-                    }
-                    break;
-                case ')':
-                    token = new Token(TokenType::rparen, pos);
-                    read();
-                    break;
-                case '[':
-                    token = new Token(TokenType::lbrack, pos);
-                    read();
-                    break;
-                case ']':
-                    token = new Token(TokenType::rbrack, pos);
-                    read();
-                    break;
-                case '~':
-                    token = new Token(TokenType::op_not, pos);
+            type = TokenType::const_number;
+            value = number();
+            break;
+        }
+        switch (ch_) {
+            case '&': type = TokenType::op_and; read(); break;
+            case '*': type = TokenType::op_times; read(); break;
+            case '+': type = TokenType::op_plus; read(); break;
+            case '-': type = TokenType::op_minus; read(); break;
+            case '=': type = TokenType::op_eq; read(); break;
+            case '#': type = TokenType::op_neq; read(); break;
+            case '<':
+                read();
+                if (ch_ == '=') {
+                    type = TokenType::op_leq;
                     read();
-                    break;
-                case '"':
-                    token = new StringToken(pos, string());
+                } else {
+                    type = TokenType::op_lt;
+                }
+                break;
+            case '>':
+                read();
+                if (ch_ == '=') {
+                    type = TokenType::op_geq;
                     read();
-                    break;
-                default:
-                    token = nullptr;
+                } else {
+                    type = TokenType::op_gt;
+                }
+                break;
+            case ';': type = TokenType::semicolon; read(); break;
+            case ',': type = TokenType::comma; read(); break;
+            case ':':
+                read();
+                if (ch_ == '=') {
+                    type = TokenType::op_becomes;
                     read();
-                    break;
-            }
+                } else {
+                    type = TokenType::colon;
+                }
+                break;
+            case '.': type = TokenType::period; read(); break;
+            case '(':
+                read();
+                if (ch_ == '*') {
+                    comment();
+                    continue;
+                }
+                type = TokenType::lparen;
+                break;
+            case ')': type = TokenType::rparen; read(); break;
+            case '[': type = TokenType::lbrack; read(); break;
+            case ']': type = TokenType::rbrack; read(); break;
+            case '~': type = TokenType::op_not; read(); break;
+            case '"':
+                type = TokenType::const_string;
+                string();
+                break;
+            default:
+                type = TokenType::null;
+                read();
+                break;
         }
-    } else {
-        token = new Token(TokenType::eof, getPosition());
+        break;
     }
-    return token;
+    return Token(type, { fileId_, (unsigned int) (base_ + (size_t) (mark_ - begin_)) }, (unsigned int) (cur_ - mark_), value);
+}
+
+/*
+ * Reads the next block of a streamed source once the scanner reaches the end of the buffer. Only the text
+ * from the token that was handed out last on is kept, and the pointers into the buffer are moved along.
+ */
+bool Scanner::refill() {
+    const size_t loaded = base_ + (size_t) (end_ - begin_);
+    const size_t cur = base_ + (size_t) (cur_ - begin_);
+    const size_t mark = base_ + (size_t) (mark_ - begin_);
+    if (!source_.refill(std::min(mark, keep_))) {
+        return false;
+    }
+    begin_ = source_.begin();
+    end_ = source_.end();
+    base_ = source_.offset();
+    cur_ = begin_ + (cur - base_);
+    mark_ = begin_ + (mark - base_);
+    FileTable::instance().append(fileId_, begin_ + (loaded - base_), base_ + (size_t) (end_ - begin_) - loaded);
+    return cur_ < end_;
 }
 
 void Scanner::read() {
-    if (ch_ == '\n') {
-        lineNo_++;
-        charNo_ = 0;
-    }
-    if (file_.get(ch_)) {
-        charNo_++;
-    } else if (file_.eof()) {
-        charNo_++;
-        ch_ = -1;
-    } else {
-        // TODO I/O Exception
-        logger_->error(filename_, "Error reading file.");
+    if (cur_ < end_) {
+        cur_++;
     }
+    ch_ = ((cur_ < end_) || refill()) ? *cur_ : (char) -1;
+}
 
+void Scanner::skipTo(const char *pos) {
+    cur_ = pos;
+    ch_ = ((cur_ < end_) || refill()) ? *cur_ : (char) -1;
 }
 
 const FilePos Scanner::getPosition() const {
-    FilePos pos;
-    pos.fileName = filename_;
-    pos.lineNo = lineNo_;
-    pos.charNo = charNo_;
-    return pos;
+    return { fileId_, (unsigned int) (base_ + (size_t) (cur_ - begin_)) };
 }
 
 void Scanner::comment() {
@@ -225,79 +462,132 @@ void Scanner::comment() {
             if (ch_ == -1) {
                 break;
             }
-            read();
+            // nothing but '(' and '*' can open or close a comment, so everything else is skipped at once
+            mark_ = cur_;
+            skipTo(SourceSkipper::commentDelimiter(cur_ + 1, end_));
         }
         if (ch_ == ')') {
             read();
             break;
         }
         if (ch_ == -1) {
-            logger_->error(pos, "Comment not terminated.");
+            error(pos, "Comment not terminated.");
             break;
         }
     }
 }
 
-const Token* Scanner::ident() {
-    FilePos pos = getPosition();
-    std::stringstream ss;
+const TokenType Scanner::ident() {
     do {
-        ss << ch_;
-        read();
-    } while (((ch_ >= '0') && (ch_ <= '9')) ||
-             ((ch_ >= 'a') && (ch_ <= 'z')) ||
-             ((ch_ >= 'A') && (ch_ <= 'Z')));
-    std::string ident = ss.str();
-    std::unordered_map<std::string, TokenType>::const_iterator it = keywords_.find(ident);
-    if (it != keywords_.end()) {
-        return new Token(it->second, pos);
-    }
-    return new IdentToken(pos, ident);
+        cur_++;
+    } while (((cur_ < end_) || refill()) && (((*cur_ >= '0') && (*cur_ <= '9')) ||
+                               ((*cur_ >= 'a') && (*cur_ <= 'z')) ||
+                               ((*cur_ >= 'A') && (*cur_ <= 'Z'))));
+    ch_ = (cur_ < end_) ? *cur_ : (char) -1;
+    return keyword(mark_, (size_t) (cur_ - mark_));
 }
 
 const int Scanner::number() {
-    bool isHex = false;
-    int decValue = 0;
-    int hexValue = 0;
     FilePos pos = getPosition();
-    do {
-        isHex = isHex | ((ch_ >= 'A') && (ch_ <= 'F'));
-        if (decValue <= ((INT_MAX - ch_ + '0') / 10)) {
-            if ((ch_ >= '0') && (ch_ <= '9')) {
-                decValue = 10 * decValue + (ch_ - '0');
-                hexValue = 16 * hexValue + (ch_ - '0');
-            } else { // A - F
-                hexValue = 16 * hexValue + (ch_ - 'A' + 10);
-            }
-        } else {
-            logger_->error(pos, "Number too large.");
-            return 0;
+    // find the end of the literal, reading more of a streamed source if it reaches the end of the window
+    size_t length = 0;
+    bool isHex = false;
+    while (true) {
+        while ((cur_ + length < end_) && isHexDigit(cur_[length])) {
+            isHex = isHex | (cur_[length] >= 'A');
+            length++;
         }
-        read();
-    } while (((ch_ >= '0') && (ch_ <= '9')) ||
-             ((ch_ >= 'A') && (ch_ <= 'F')));
+        if ((cur_ + length < end_) || !refill()) {
+            break;
+        }
+    }
+    // reading past the literal may refill a streamed source and move the window, so the digits are located by
+    // their offset in the source, which stays in the window as it is part of the current token
+    const size_t start = base_ + (size_t) (cur_ - begin_);
+    skipTo(cur_ + length);
     if (ch_ == 'H') {
         // hexadecimal number identified by trailing 'H'
         isHex = true;
         read();
     }
+    const char *digits = begin_ + (start - base_);
+    // leading zeros do not count towards the range of the value
+    while ((length > 1) && (*digits == '0')) {
+        digits++;
+        length--;
+    }
     if (isHex) {
-        return hexValue;
+        if (length > MAX_HEX_DIGITS) {
+            error(pos, "Number too large.");
+            return 0;
+        }
+        // hexadecimal literals denote a 32-bit pattern, e.g., 0FFFFFFFFH is -1
+        uint32_t value = 0;
+        for (size_t i = 0; i < length; i++) {
+            value = 16 * value + (uint32_t) ((digits[i] <= '9') ? (digits[i] - '0') : (digits[i] - 'A' + 10));
+        }
+        return (int) value;
+    }
+    if (length > MAX_DECIMAL_DIGITS) {
+        error(pos, "Number too large.");
+        return 0;
+    }
+    uint64_t value = 0;
+    size_t i = 0;
+    if (length >= 8) {
+        value = parseEightDigits(digits);
+        i = 8;
     }
-    return decValue;
+    for (; i < length; i++) {
+        value = 10 * value + (uint64_t) (digits[i] - '0');
+    }
+    if (value > (uint64_t) INT_MAX) {
+        error(pos, "Number too large.");
+        return 0;
+    }
+    return (int) value;
 }
 
-const std::string Scanner::string() {
-    std::stringstream ss;
+void Scanner::string() {
+    // the literal, including its quotes, stays in the buffer and is referenced by the token
+    FilePos pos = getPosition();
     do {
-        ss << ch_;
         if (ch_ == '\\') {
             read();
-            ss << ch_;
         }
         read();
-    } while (ch_ != '"');
-    ss << ch_;
-    std::string s = ss.str();
-    return s;
+    } while ((ch_ != '"') && (ch_ != -1));
+    if (ch_ == -1) {
+        error(pos, "String not terminated.");
+    } else {
+        read();
+    }
+}
+
+/*
+ * Decodes the text of a string literal, i.e., removes its quotes and replaces escape sequences by the characters
+ * they stand for. The scanner leaves literals as they are in the source, so only consumers that need the value of
+ * a string pay for decoding it.
+ */
+const std::string Scanner::decode(const std::string &literal) {
+    std::string value;
+    value.reserve(literal.size());
+    for (size_t i = 1; i < literal.size(); i++) {
+        char c = literal[i];
+        if (c == '"') {
+            break;
+        }
+        if (c == '\\' && i + 1 < literal.size()) {
+            c = literal[++i];
+            if (c == 'n') {
+                c = '\n';
+            } else if (c == 't') {
+                c = '\t';
+            } else if (c == 'r') {
+                c = '\r';
+            }
+        }
+        value += c;
+    }
+    return value;
 }
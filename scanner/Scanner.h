@@ -7,40 +7,135 @@
 #ifndef OBERON0C_SCANNER_H
 #define OBERON0C_SCANNER_H
 
+#include <cstdint>
 #include <memory>
 #include <string>
-#include <fstream>
 #include <sstream>
-#include <unordered_map>
+#include <vector>
 #include "Token.h"
+#include "SourceBuffer.h"
 #include "../util/Logger.h"
 
 
+/*
+ * The scanner has two interchangeable engines that produce identical token streams: a hand-written
+ * one (direct) and one driven by compile-time generated character class and transition tables (table).
+ */
+enum class ScanEngine : char { direct, table };
+
+/*
+ * Large sources can also be scanned by several threads at once (see setThreads), in which case the
+ * scanner tokenizes the complete source before handing out the first token.
+ */
+struct ScanChunk;
+struct ScanSegment;
+
+/*
+ * Scanned token streams can be cached on disk (see setCacheDirectory). A cached stream is used instead of
+ * scanning the source again as long as the content of the source is the same.
+ */
+
+/*
+ * An edit of the source text: the given number of characters at the offset are replaced by the inserted text.
+ */
+struct TextEdit {
+    unsigned int offset;
+    unsigned int removed;
+    std::string inserted;
+};
+
+/*
+ * The tokens that an edit replaced: starting at index first, the removed tokens were replaced by the inserted ones.
+ */
+struct TokenRange {
+    size_t first;
+    size_t removed;
+    size_t inserted;
+};
+
 class Scanner {
 
+public:
+    // Capacity of the token buffer; a power of two that bounds the supported lookahead.
+    static const size_t TOKEN_BUFFER_SIZE = 256;
+
 private:
     std::string filename_;
     const Logger *logger_;
-    const Token *token_;
-    int lineNo_, charNo_;
-    std::unordered_map<std::string, TokenType> keywords_;
-    std::ifstream file_;
+    ScanEngine engine_;
+    Token tokens_[TOKEN_BUFFER_SIZE];
+    size_t head_, count_;
+    bool eof_;
+    unsigned int fileId_;
+    SourceBuffer source_;
+    // offset of the beginning of the buffer in the source, which is only non-zero for streamed sources
+    size_t base_;
+    const char *begin_, *cur_, *end_;
+    // start of the token that is being scanned and offset of the token that was handed out last
+    const char *mark_;
+    size_t keep_;
     char ch_;
+    unsigned int threads_;
+    // the complete token stream, once the source has been scanned in parallel or for editing
+    std::vector<Token> scanned_;
+    // the tokens after the most recent edit in reverse order, with offsets relative to the end of the source
+    std::vector<Token> tail_;
+    size_t scannedNext_;
+    bool complete_;
+    std::string text_;
+    // set if this scanner only scans a chunk of the source of another scanner on a worker thread
+    ScanChunk *chunk_;
+    IdentTable *idents_;
+    // directory of the token cache, which is not used if empty
+    std::string cacheDir_;
+    unsigned int errors_;
+
+    explicit Scanner(const Scanner &parent, ScanChunk *chunk, const char *start);
 
-    void initTable();
+    void init();
+    void error(FilePos pos, const std::string &msg);
+    bool refill();
     void read();
+    void skipTo(const char *pos);
+    void fill();
     const FilePos getPosition() const;
-    const Token* next();
-    const Token* ident();
+    const Token next();
+    const Token nextTable();
+    const TokenType ident();
     const int number();
-    const std::string string();
+    void string();
     void comment();
+    void scanAll();
+    void moveSplit(size_t offset);
+    void scanParallel();
+    size_t scanChunk(const std::vector<Token> *speculative);
+    void accept(ScanChunk &chunk, size_t from, size_t to, size_t start, std::vector<ScanSegment> &segments);
+    void scanCached();
+    bool loadCache(const std::string &path, uint64_t hash);
+    void saveCache(const std::string &path, uint64_t hash) const;
+
+    static const TokenType keyword(const char *start, size_t length);
 
 public:
     explicit Scanner(const std::string &filename, const Logger *logger);
+    explicit Scanner(const std::string &name, const char *data, size_t size, const Logger *logger);
+    explicit Scanner(const std::string &name, std::istream &stream, const Logger *logger);
     ~Scanner();
-    const Token* peekToken();
-    std::unique_ptr<const Token> nextToken();
+    const Token& peekToken(size_t lookahead = 0);
+    const Token nextToken();
+    const std::string getText(const Token &token) const;
+    static const std::string decode(const std::string &literal);
+
+    void setEngine(ScanEngine engine);
+    const ScanEngine getEngine() const;
+    void setThreads(unsigned int threads);
+    const unsigned int getThreads() const;
+    void setCacheDirectory(const std::string &directory);
+    const std::string getCacheDirectory() const;
+
+    const std::vector<Token>& getTokens();
+    const TokenRange edit(const TextEdit &edit);
+    void rewind();
 
 };
 
@@ -0,0 +1,148 @@
+/*
+ * Implementation of the source buffer used by the scanner of the Oberon-0 compiler.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include "SourceBuffer.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define OBERON0C_HAS_MMAP
+#endif
+
+const size_t SourceBuffer::BLOCK_SIZE;
+
+SourceBuffer::SourceBuffer() : data_(nullptr), size_(0), offset_(0), mapping_(nullptr), contents_(), stream_(nullptr) {
+}
+
+SourceBuffer::~SourceBuffer() {
+    release();
+}
+
+void SourceBuffer::release() {
+#ifdef OBERON0C_HAS_MMAP
+    if (mapping_) {
+        munmap(mapping_, size_);
+    }
+#endif
+    mapping_ = nullptr;
+    contents_.clear();
+    stream_ = nullptr;
+    data_ = nullptr;
+    size_ = 0;
+    offset_ = 0;
+}
+
+bool SourceBuffer::open(const std::string &filename) {
+    release();
+#ifdef OBERON0C_HAS_MMAP
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        void *mapping = mmap(nullptr, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+#ifdef MADV_SEQUENTIAL
+            madvise(mapping, (size_t) st.st_size, MADV_SEQUENTIAL);
+#endif
+            close(fd);
+            mapping_ = mapping;
+            data_ = static_cast<const char*>(mapping);
+            size_ = (size_t) st.st_size;
+            return true;
+        }
+    }
+    close(fd);
+#endif
+    // fall back to reading the whole file into a single contiguous buffer
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    contents_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    if (file.bad()) {
+        contents_.clear();
+        return false;
+    }
+    data_ = contents_.data();
+    size_ = contents_.size();
+    return true;
+}
+
+void SourceBuffer::assign(const char *data, size_t size) {
+    // the data is used in place and has to outlive the buffer
+    release();
+    data_ = data;
+    size_ = size;
+}
+
+void SourceBuffer::stream(std::istream *stream) {
+    release();
+    stream_ = stream;
+    contents_.resize(2 * BLOCK_SIZE);
+    data_ = contents_.data();
+}
+
+/*
+ * Reads the next block of a streamed source. Everything before the given (absolute) offset is dropped
+ * from the window, which moves the window forward. Returns false if there is nothing left to read.
+ */
+bool SourceBuffer::refill(size_t keep) {
+    if (stream_ == nullptr) {
+        return false;
+    }
+    if (stream_->rdbuf()->sgetc() == std::char_traits<char>::eof()) {
+        // the window must not move if nothing is read, as the scanner only rebases its pointers after a refill
+        stream_ = nullptr;
+        return false;
+    }
+    keep = std::min(std::max(keep, offset_), offset_ + size_);
+    const size_t drop = keep - offset_;
+    if (drop > 0) {
+        memmove(contents_.data(), contents_.data() + drop, size_ - drop);
+        offset_ += drop;
+        size_ -= drop;
+    }
+    if (contents_.size() - size_ < BLOCK_SIZE) {
+        // everything in the window is still needed, e.g., for a very long string literal
+        contents_.resize(2 * contents_.size());
+    }
+    data_ = contents_.data();
+    const std::streamsize read = stream_->rdbuf()->sgetn(contents_.data() + size_,
+                                                         (std::streamsize) (contents_.size() - size_));
+    if (read <= 0) {
+        stream_ = nullptr;
+        return false;
+    }
+    size_ += (size_t) read;
+    return true;
+}
+
+const char* SourceBuffer::begin() const {
+    return data_;
+}
+
+const char* SourceBuffer::end() const {
+    return data_ + size_;
+}
+
+size_t SourceBuffer::size() const {
+    return size_;
+}
+
+size_t SourceBuffer::offset() const {
+    // for streamed sources, the offset of the beginning of the window in the source
+    return offset_;
+}
+
+bool SourceBuffer::isComplete() const {
+    return stream_ == nullptr && offset_ == 0;
+}
@@ -0,0 +1,60 @@
+/*
+ * Header file of the source buffer used by the scanner of the Oberon-0 compiler.
+ *
+ * The buffer maps the complete source file into memory (or reads it once into a
+ * contiguous block if mapping is not possible), so that the scanner can walk the
+ * characters with a raw pointer instead of pulling them one by one from a stream.
+ * Sources that are already in memory are used in place.
+ *
+ * Sources that are streamed, e.g., from a pipe, are read block by block into a window of
+ * bounded size instead. Whenever the scanner reaches the end of the window, the part of
+ * the window that is still needed is moved to its front and the rest is refilled from the
+ * stream. The window only grows if a single token does not fit into it.
+ */
+
+#ifndef OBERON0C_SOURCEBUFFER_H
+#define OBERON0C_SOURCEBUFFER_H
+
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <vector>
+
+class SourceBuffer {
+
+private:
+    const char *data_;
+    size_t size_;
+    size_t offset_;
+    void *mapping_;
+    std::vector<char> contents_;
+    std::istream *stream_;
+
+    void release();
+
+public:
+    explicit SourceBuffer();
+    ~SourceBuffer();
+
+    SourceBuffer(const SourceBuffer &) = delete;
+    SourceBuffer& operator=(const SourceBuffer &) = delete;
+
+    // size of the blocks in which streamed sources are read
+    static const size_t BLOCK_SIZE = 64 * 1024;
+
+    bool open(const std::string &filename);
+    void assign(const char *data, size_t size);
+    void stream(std::istream *stream);
+    bool refill(size_t keep);
+
+    const char* begin() const;
+    const char* end() const;
+    size_t size() const;
+    size_t offset() const;
+    bool isComplete() const;
+
+};
+
+
+#endif //OBERON0C_SOURCEBUFFER_H
@@ -0,0 +1,166 @@
+/*
+ * Implementation of the source skipper used by the scanner of the Oberon-0 compiler.
+ *
+ * The scanner treats every character up to and including ' ' as whitespace, except for (char) -1,
+ * which it reads as end of input. Inside comments, only '(', '*' and (char) -1 are of interest.
+ * Since characters are signed, the vector code uses signed comparisons to match these rules exactly.
+ */
+
+#include "SourceSkipper.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define OBERON0C_HAS_X86_SIMD
+#endif
+
+static inline bool isWhitespace(const char ch) {
+    return (ch <= ' ') && (ch != (char) -1);
+}
+
+static inline bool isCommentDelimiter(const char ch) {
+    return (ch == '(') || (ch == '*') || (ch == (char) -1);
+}
+
+static const char* whitespaceScalar(const char *p, const char *end) {
+    while ((p < end) && isWhitespace(*p)) {
+        p++;
+    }
+    return p;
+}
+
+static const char* commentDelimiterScalar(const char *p, const char *end) {
+    while ((p < end) && !isCommentDelimiter(*p)) {
+        p++;
+    }
+    return p;
+}
+
+#ifdef OBERON0C_HAS_X86_SIMD
+
+static const char* whitespaceSse2(const char *p, const char *end) {
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i eof = _mm_set1_epi8((char) -1);
+    while (end - p >= 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i stop = _mm_or_si128(_mm_cmpgt_epi8(block, space), _mm_cmpeq_epi8(block, eof));
+        const unsigned int mask = (unsigned int) _mm_movemask_epi8(stop);
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 16;
+    }
+    return whitespaceScalar(p, end);
+}
+
+static const char* commentDelimiterSse2(const char *p, const char *end) {
+    const __m128i lparen = _mm_set1_epi8('(');
+    const __m128i star = _mm_set1_epi8('*');
+    const __m128i eof = _mm_set1_epi8((char) -1);
+    while (end - p >= 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i stop = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, lparen), _mm_cmpeq_epi8(block, star)),
+                                          _mm_cmpeq_epi8(block, eof));
+        const unsigned int mask = (unsigned int) _mm_movemask_epi8(stop);
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 16;
+    }
+    return commentDelimiterScalar(p, end);
+}
+
+__attribute__((target("avx2")))
+static const char* whitespaceAvx2(const char *p, const char *end) {
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i eof = _mm256_set1_epi8((char) -1);
+    while (end - p >= 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const __m256i stop = _mm256_or_si256(_mm256_cmpgt_epi8(block, space), _mm256_cmpeq_epi8(block, eof));
+        const unsigned int mask = (unsigned int) _mm256_movemask_epi8(stop);
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 32;
+    }
+    return whitespaceSse2(p, end);
+}
+
+__attribute__((target("avx2")))
+static const char* commentDelimiterAvx2(const char *p, const char *end) {
+    const __m256i lparen = _mm256_set1_epi8('(');
+    const __m256i star = _mm256_set1_epi8('*');
+    const __m256i eof = _mm256_set1_epi8((char) -1);
+    while (end - p >= 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const __m256i stop = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, lparen),
+                                                             _mm256_cmpeq_epi8(block, star)),
+                                             _mm256_cmpeq_epi8(block, eof));
+        const unsigned int mask = (unsigned int) _mm256_movemask_epi8(stop);
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 32;
+    }
+    return commentDelimiterSse2(p, end);
+}
+
+#endif
+
+typedef const char* (*SkipFunction)(const char *p, const char *end);
+
+struct SkipFunctions {
+    SkipIsa isa;
+    SkipFunction whitespace;
+    SkipFunction commentDelimiter;
+};
+
+static SkipFunctions functionsFor(const SkipIsa isa) {
+    switch (isa) {
+#ifdef OBERON0C_HAS_X86_SIMD
+        case SkipIsa::avx2: return { SkipIsa::avx2, whitespaceAvx2, commentDelimiterAvx2 };
+        case SkipIsa::sse2: return { SkipIsa::sse2, whitespaceSse2, commentDelimiterSse2 };
+#endif
+        default: return { SkipIsa::scalar, whitespaceScalar, commentDelimiterScalar };
+    }
+}
+
+static SkipIsa detectIsa() {
+#ifdef OBERON0C_HAS_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return SkipIsa::avx2;
+    }
+    return SkipIsa::sse2;
+#else
+    return SkipIsa::scalar;
+#endif
+}
+
+static SkipFunctions skip = functionsFor(detectIsa());
+
+const char* SourceSkipper::whitespace(const char *p, const char *end) {
+    return skip.whitespace(p, end);
+}
+
+const char* SourceSkipper::commentDelimiter(const char *p, const char *end) {
+    return skip.commentDelimiter(p, end);
+}
+
+SkipIsa SourceSkipper::getIsa() {
+    return skip.isa;
+}
+
+bool SourceSkipper::isSupported(const SkipIsa isa) {
+    switch (isa) {
+        case SkipIsa::scalar: return true;
+        case SkipIsa::sse2: return detectIsa() != SkipIsa::scalar;
+        case SkipIsa::avx2: return detectIsa() == SkipIsa::avx2;
+    }
+    return false;
+}
+
+void SourceSkipper::setIsa(const SkipIsa isa) {
+    if (isSupported(isa)) {
+        skip = functionsFor(isa);
+    }
+}
@@ -0,0 +1,30 @@
+/*
+ * Header file of the source skipper used by the scanner of the Oberon-0 compiler.
+ *
+ * The skipper advances over runs of whitespace and over the bodies of comments in blocks of 16 (SSE2)
+ * or 32 (AVX2) bytes. The implementation is selected at runtime based on the capabilities of the CPU,
+ * with a portable scalar fallback that is always available.
+ */
+
+#ifndef OBERON0C_SOURCESKIPPER_H
+#define OBERON0C_SOURCESKIPPER_H
+
+
+enum class SkipIsa : char { scalar, sse2, avx2 };
+
+class SourceSkipper {
+
+public:
+    // Returns the first character in [p, end) that is not whitespace (or end).
+    static const char* whitespace(const char *p, const char *end);
+    // Returns the first character in [p, end) that may open or close a comment (or end).
+    static const char* commentDelimiter(const char *p, const char *end);
+
+    static SkipIsa getIsa();
+    static bool isSupported(SkipIsa isa);
+    static void setIsa(SkipIsa isa);
+
+};
+
+
+#endif //OBERON0C_SOURCESKIPPER_H
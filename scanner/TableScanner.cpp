@@ -0,0 +1,194 @@
+/*
+ * Implementation of the table-driven engine of the scanner used by the Oberon-0 compiler.
+ *
+ * The engine is a deterministic finite automaton over character classes. Both the character class
+ * table and the transition table are computed by constexpr functions at compile time, so the inner
+ * loop of the scanner is a table lookup per byte. Transitions with the ACCEPT bit set end the token
+ * without consuming the current character and select the action that builds the token. Numbers and
+ * (nested) comments are handed off to the same routines that the hand-written engine uses, so that
+ * both engines produce identical token streams.
+ */
+
+#include "Scanner.h"
+
+enum CharClass : unsigned char {
+    C_EOF, C_WS, C_LETTER, C_DIGIT, C_SINGLE, C_LT, C_GT, C_COLON, C_EQ, C_LPAREN, C_STAR, C_QUOTE, C_BACKSLASH,
+    C_OTHER,
+    CLASS_COUNT
+};
+
+enum State : unsigned char {
+    S_START, S_IDENT, S_SINGLE, S_LT, S_GT, S_COLON, S_LPAREN, S_LEQ, S_GEQ, S_BECOMES, S_STRING, S_ESCAPE,
+    S_STRING_END, S_NULL,
+    STATE_COUNT
+};
+
+enum Action : unsigned char {
+    A_EOF, A_IDENT, A_NUMBER, A_SINGLE, A_LT, A_GT, A_COLON, A_LPAREN, A_LEQ, A_GEQ, A_BECOMES, A_COMMENT,
+    A_STRING, A_UNTERMINATED, A_NULL,
+    ACTION_COUNT
+};
+
+static constexpr unsigned char ACCEPT = 0x80;
+
+struct ScanTables {
+    unsigned char charClass[256];
+    unsigned char transition[STATE_COUNT][CLASS_COUNT];
+    TokenType singleType[256];
+    TokenType actionType[ACTION_COUNT];
+};
+
+static constexpr unsigned char classify(const int c) {
+    // characters are signed in the scanner: (char) -1 ends the input and everything else up to ' ' is whitespace
+    return ((char) c == (char) -1) ? C_EOF :
+           ((char) c <= ' ') ? C_WS :
+           ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')) ? C_LETTER :
+           (c >= '0' && c <= '9') ? C_DIGIT :
+           (c == '<') ? C_LT :
+           (c == '>') ? C_GT :
+           (c == ':') ? C_COLON :
+           (c == '=') ? C_EQ :
+           (c == '(') ? C_LPAREN :
+           (c == '*') ? C_STAR :
+           (c == '"') ? C_QUOTE :
+           (c == '\\') ? C_BACKSLASH :
+           (c == '&' || c == '+' || c == '-' || c == '#' || c == ';' || c == ',' || c == '.' || c == ')' ||
+            c == '[' || c == ']' || c == '~') ? C_SINGLE :
+           C_OTHER;
+}
+
+static constexpr ScanTables buildTables() {
+    ScanTables t {};
+    for (int c = 0; c < 256; c++) {
+        t.charClass[c] = classify(c);
+        t.singleType[c] = TokenType::null;
+    }
+    t.singleType[(unsigned char) '&'] = TokenType::op_and;
+    t.singleType[(unsigned char) '*'] = TokenType::op_times;
+    t.singleType[(unsigned char) '+'] = TokenType::op_plus;
+    t.singleType[(unsigned char) '-'] = TokenType::op_minus;
+    t.singleType[(unsigned char) '='] = TokenType::op_eq;
+    t.singleType[(unsigned char) '#'] = TokenType::op_neq;
+    t.singleType[(unsigned char) ';'] = TokenType::semicolon;
+    t.singleType[(unsigned char) ','] = TokenType::comma;
+    t.singleType[(unsigned char) '.'] = TokenType::period;
+    t.singleType[(unsigned char) ')'] = TokenType::rparen;
+    t.singleType[(unsigned char) '['] = TokenType::lbrack;
+    t.singleType[(unsigned char) ']'] = TokenType::rbrack;
+    t.singleType[(unsigned char) '~'] = TokenType::op_not;
+
+    for (int a = 0; a < ACTION_COUNT; a++) {
+        t.actionType[a] = TokenType::null;
+    }
+    t.actionType[A_EOF] = TokenType::eof;
+    t.actionType[A_LT] = TokenType::op_lt;
+    t.actionType[A_GT] = TokenType::op_gt;
+    t.actionType[A_COLON] = TokenType::colon;
+    t.actionType[A_LPAREN] = TokenType::lparen;
+    t.actionType[A_LEQ] = TokenType::op_leq;
+    t.actionType[A_GEQ] = TokenType::op_geq;
+    t.actionType[A_BECOMES] = TokenType::op_becomes;
+    t.actionType[A_STRING] = TokenType::const_string;
+    t.actionType[A_UNTERMINATED] = TokenType::const_string;
+
+    // states that end the token on whatever comes next
+    const unsigned char done[][2] = { { S_SINGLE, A_SINGLE }, { S_LEQ, A_LEQ }, { S_GEQ, A_GEQ },
+                                      { S_BECOMES, A_BECOMES }, { S_STRING_END, A_STRING }, { S_NULL, A_NULL } };
+    for (auto &d : done) {
+        for (int c = 0; c < CLASS_COUNT; c++) {
+            t.transition[d[0]][c] = ACCEPT | d[1];
+        }
+    }
+    for (int c = 0; c < CLASS_COUNT; c++) {
+        t.transition[S_IDENT][c] = ACCEPT | A_IDENT;
+        t.transition[S_LT][c] = ACCEPT | A_LT;
+        t.transition[S_GT][c] = ACCEPT | A_GT;
+        t.transition[S_COLON][c] = ACCEPT | A_COLON;
+        t.transition[S_LPAREN][c] = ACCEPT | A_LPAREN;
+        t.transition[S_STRING][c] = S_STRING;
+        t.transition[S_ESCAPE][c] = S_STRING;
+    }
+
+    t.transition[S_START][C_EOF] = ACCEPT | A_EOF;
+    t.transition[S_START][C_WS] = S_START;
+    t.transition[S_START][C_LETTER] = S_IDENT;
+    t.transition[S_START][C_DIGIT] = ACCEPT | A_NUMBER;
+    t.transition[S_START][C_SINGLE] = S_SINGLE;
+    t.transition[S_START][C_EQ] = S_SINGLE;
+    t.transition[S_START][C_STAR] = S_SINGLE;
+    t.transition[S_START][C_LT] = S_LT;
+    t.transition[S_START][C_GT] = S_GT;
+    t.transition[S_START][C_COLON] = S_COLON;
+    t.transition[S_START][C_LPAREN] = S_LPAREN;
+    t.transition[S_START][C_QUOTE] = S_STRING;
+    t.transition[S_START][C_BACKSLASH] = S_NULL;
+    t.transition[S_START][C_OTHER] = S_NULL;
+
+    t.transition[S_IDENT][C_LETTER] = S_IDENT;
+    t.transition[S_IDENT][C_DIGIT] = S_IDENT;
+    t.transition[S_LT][C_EQ] = S_LEQ;
+    t.transition[S_GT][C_EQ] = S_GEQ;
+    t.transition[S_COLON][C_EQ] = S_BECOMES;
+    t.transition[S_LPAREN][C_STAR] = ACCEPT | A_COMMENT;
+
+    t.transition[S_STRING][C_EOF] = ACCEPT | A_UNTERMINATED;
+    t.transition[S_STRING][C_BACKSLASH] = S_ESCAPE;
+    t.transition[S_STRING][C_QUOTE] = S_STRING_END;
+    t.transition[S_ESCAPE][C_EOF] = ACCEPT | A_UNTERMINATED;
+    return t;
+}
+
+static constexpr ScanTables TABLES = buildTables();
+
+const Token Scanner::nextTable() {
+    unsigned char action;
+    TokenType type;
+    int value = 0;
+    while (true) {
+        mark_ = cur_;
+        unsigned char state = S_START;
+        while (true) {
+            const unsigned char cls = ((cur_ < end_) || refill()) ? TABLES.charClass[(unsigned char) *cur_]
+                                                                  : (unsigned char) C_EOF;
+            const unsigned char next = TABLES.transition[state][cls];
+            if (next & ACCEPT) {
+                action = next & (unsigned char) ~ACCEPT;
+                break;
+            }
+            cur_++;
+            state = next;
+            if (state == S_START) {
+                mark_ = cur_;
+            }
+        }
+        skipTo(cur_);
+        if (action != A_COMMENT) {
+            break;
+        }
+        comment();
+    }
+    const FilePos pos = { fileId_, (unsigned int) (base_ + (size_t) (mark_ - begin_)) };
+    switch (action) {
+        case A_IDENT:
+            type = keyword(mark_, (size_t) (cur_ - mark_));
+            if (type == TokenType::const_ident) {
+                value = (int) idents_->intern(mark_, (size_t) (cur_ - mark_)).getId();
+            }
+            break;
+        case A_NUMBER:
+            type = TokenType::const_number;
+            value = number();
+            break;
+        case A_SINGLE:
+            type = TABLES.singleType[(unsigned char) *mark_];
+            break;
+        case A_UNTERMINATED:
+            type = TokenType::const_string;
+            error(pos, "String not terminated.");
+            break;
+        default:
+            type = TABLES.actionType[action];
+            break;
+    }
+    return Token(type, pos, (unsigned int) (cur_ - mark_), value);
+}
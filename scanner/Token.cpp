@@ -6,10 +6,12 @@
 
 #include "Token.h"
 
-Token::Token(TokenType type, FilePos pos) : type_(type), pos_(pos) {
+Token::Token() : type_(TokenType::null), pos_({ FileTable::NO_FILE, 0 }), length_(0), value_(0) {
 }
 
-Token::~Token() = default;
+Token::Token(TokenType type, FilePos pos, unsigned int length, int value) :
+        type_(type), pos_(pos), length_(length), value_(value) {
+}
 
 const TokenType Token::getType() const {
     return type_;
@@ -19,8 +21,35 @@ const FilePos Token::getPosition() const {
     return pos_;
 }
 
+const unsigned int Token::getOffset() const {
+    return pos_.offset;
+}
+
+const unsigned int Token::getLength() const {
+    return length_;
+}
+
+const int Token::getValue() const {
+    return value_;
+}
+
+const Ident Token::getIdent() const {
+    return (type_ == TokenType::const_ident) ? Ident((unsigned int) value_) : Ident();
+}
+
+const Token Token::shifted(int delta) const {
+    Token token = *this;
+    token.pos_.offset += (unsigned int) delta;
+    return token;
+}
+
 void Token::print(std::ostream &stream) const {
     stream << type_;
+    if (type_ == TokenType::const_number) {
+        stream << ": " << value_;
+    } else if (type_ == TokenType::const_ident) {
+        stream << ": " << getIdent();
+    }
 }
 
 std::ostream& operator<<(std::ostream &stream, const Token &symbol) {
@@ -10,6 +10,7 @@
 
 #include <ostream>
 #include "../util/Logger.h"
+#include "../util/Ident.h"
 
 enum class TokenType : char {
     eof, null,
@@ -23,20 +24,33 @@ enum class TokenType : char {
 
 std::ostream& operator<<(std::ostream &stream, const TokenType &type);
 
+/*
+ * Tokens are small, trivially-copyable values that are handed out by the scanner and consumed
+ * by the parser by value. The position of a token is also the offset of its text in the source
+ * buffer of the scanner, which is how string literals refer to their text. Number tokens carry their
+ * value and identifier tokens their interned id as payload.
+ */
 class Token {
 
 private:
     TokenType type_;
     FilePos pos_;
+    unsigned int length_;
+    int value_;
 
 public:
-    Token(TokenType type, FilePos pos);
-    virtual ~Token();
+    Token();
+    Token(TokenType type, FilePos pos, unsigned int length, int value = 0);
 
     const TokenType getType() const;
     const FilePos getPosition() const;
+    const unsigned int getOffset() const;
+    const unsigned int getLength() const;
+    const int getValue() const;
+    const Ident getIdent() const;
+    const Token shifted(int delta) const;
 
-    virtual void print(std::ostream &stream) const;
+    void print(std::ostream &stream) const;
     friend std::ostream& operator<<(std::ostream &stream, const Token &symbol);
 
 };
@@ -0,0 +1,211 @@
+/*
+ * Implementation of the token cache of the scanner used by the Oberon-0 compiler.
+ *
+ * After a source has been scanned without errors, its token stream is written to a file in the cache
+ * directory that is named after a hash of the content of the source. The file consists of a fixed-size
+ * header, followed by an eight-byte record per token, the values of the number and identifier tokens in
+ * order, and the names of the identifiers in the order in which they first occur. When the file is loaded,
+ * it is mapped and every record is validated and decoded into a token. Identifier tokens refer to the names
+ * by index, and interning the names in this order assigns the same ids as scanning would. String tokens keep
+ * their position and length in the source, which is mapped as usual. The header repeats the hash and the
+ * size of the source, so that a stale or foreign file is never used.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include "Scanner.h"
+
+struct CacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t hash;
+    uint64_t sourceSize;
+    uint32_t tokenCount;
+    uint32_t valueCount;
+    uint32_t identCount;
+    uint32_t namesSize;
+};
+
+struct CacheToken {
+    uint32_t offset;
+    // the type in the lowest byte and the length above it
+    uint32_t info;
+};
+
+static const uint32_t MAX_CACHED_LENGTH = 0xFFFFFF;
+
+static const char CACHE_MAGIC[4] = { 'O', 'T', 'O', 'K' };
+// to be incremented whenever the layout of the file or the token types change
+static const uint32_t CACHE_VERSION = 1;
+
+static_assert(sizeof(CacheHeader) == 40, "the cache header must not contain padding");
+static_assert(sizeof(CacheToken) == 8, "the cache token record must not contain padding");
+static_assert((unsigned char) TokenType::kw_of < 0xFF, "token types must fit into a byte");
+
+static bool hasValue(const TokenType type) {
+    return type == TokenType::const_number || type == TokenType::const_ident;
+}
+
+/*
+ * Hashes the source a word at a time, so that checking the cache costs a fraction of scanning the source.
+ */
+static uint64_t hashSource(const char *data, const size_t size) {
+    const uint64_t multiplier = 0xFF51AFD7ED558CCDULL;
+    uint64_t hash = 0x9E3779B97F4A7C15ULL ^ size;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * multiplier;
+        hash ^= hash >> 32;
+    }
+    uint64_t word = 0;
+    memcpy(&word, data + i, size - i);
+    hash = (hash ^ word) * multiplier;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+void Scanner::scanCached() {
+    if (!source_.isComplete()) {
+        // streamed sources are not cached, as their content is only known once they have been read
+        if (threads_ > 1) {
+            scanParallel();
+        }
+        return;
+    }
+    const size_t size = (size_t) (end_ - begin_);
+    const uint64_t hash = hashSource(begin_, size);
+    char name[17];
+    snprintf(name, sizeof(name), "%016llx", (unsigned long long) hash);
+    const std::string path = cacheDir_ + "/" + name + ".otok";
+    if (loadCache(path, hash)) {
+        return;
+    }
+    scanAll();
+    if (errors_ == 0) {
+        // sources with errors are not cached, so that their errors are reported every time
+        saveCache(path, hash);
+    }
+}
+
+bool Scanner::loadCache(const std::string &path, const uint64_t hash) {
+    SourceBuffer file;
+    if (!file.open(path) || file.size() < sizeof(CacheHeader)) {
+        return false;
+    }
+    CacheHeader header;
+    memcpy(&header, file.begin(), sizeof(header));
+    const size_t size = (size_t) (end_ - begin_);
+    if (memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || header.version != CACHE_VERSION ||
+        header.hash != hash || header.sourceSize != size || header.tokenCount == 0 ||
+        file.size() != sizeof(CacheHeader) + (size_t) header.tokenCount * sizeof(CacheToken) +
+                       ((size_t) header.valueCount + header.identCount) * sizeof(uint32_t) + header.namesSize) {
+        return false;
+    }
+    const char *tokens = file.begin() + sizeof(CacheHeader);
+    const char *values = tokens + (size_t) header.tokenCount * sizeof(CacheToken);
+    const char *ends = values + (size_t) header.valueCount * sizeof(uint32_t);
+    const char *names = ends + (size_t) header.identCount * sizeof(uint32_t);
+
+    // the names are interned in order of first occurrence, which assigns the ids that scanning would assign
+    std::vector<unsigned int> ids(header.identCount + 1, Ident::NONE);
+    uint32_t start = 0;
+    for (uint32_t i = 0; i < header.identCount; i++) {
+        uint32_t end;
+        memcpy(&end, ends + i * sizeof(uint32_t), sizeof(end));
+        if (end < start || end > header.namesSize) {
+            return false;
+        }
+        ids[i + 1] = idents_->intern(names + start, end - start).getId();
+        start = end;
+    }
+    std::vector<Token> scanned;
+    scanned.reserve(header.tokenCount);
+    uint32_t next = 0;
+    for (uint32_t i = 0; i < header.tokenCount; i++) {
+        CacheToken record;
+        memcpy(&record, tokens + (size_t) i * sizeof(CacheToken), sizeof(record));
+        const TokenType type = (TokenType) (record.info & 0xFF);
+        const uint32_t length = record.info >> 8;
+        if ((record.info & 0xFF) > (uint32_t) TokenType::kw_of || (uint64_t) record.offset + length > size) {
+            return false;
+        }
+        int32_t value = 0;
+        if (hasValue(type)) {
+            if (next == header.valueCount) {
+                return false;
+            }
+            memcpy(&value, values + (size_t) next++ * sizeof(uint32_t), sizeof(value));
+            if (type == TokenType::const_ident) {
+                if (value < 1 || (uint32_t) value > header.identCount) {
+                    return false;
+                }
+                value = (int32_t) ids[(size_t) value];
+            }
+        }
+        scanned.emplace_back(type, FilePos { fileId_, record.offset }, length, value);
+    }
+    if (next != header.valueCount || scanned.back().getType() != TokenType::eof) {
+        return false;
+    }
+    scanned_.swap(scanned);
+    complete_ = true;
+    return true;
+}
+
+void Scanner::saveCache(const std::string &path, const uint64_t hash) const {
+    std::vector<uint32_t> locals(idents_->size() + 1, 0);
+    std::vector<CacheToken> records(scanned_.size() + tail_.size());
+    std::vector<int32_t> values;
+    std::vector<uint32_t> ends;
+    std::string names;
+    for (size_t i = 0; i < records.size(); i++) {
+        const Token token = (i < scanned_.size()) ? scanned_[i] :
+                            tail_[tail_.size() - 1 - (i - scanned_.size())].shifted((int) (end_ - begin_));
+        if (token.getLength() > MAX_CACHED_LENGTH) {
+            // a literal that does not fit into a record, which is too rare to be worth a cache entry
+            return;
+        }
+        records[i].offset = token.getOffset();
+        records[i].info = (token.getLength() << 8) | (uint32_t) (unsigned char) token.getType();
+        if (token.getType() == TokenType::const_ident) {
+            uint32_t &local = locals[(size_t) token.getValue()];
+            if (local == 0) {
+                names += token.getIdent().getName();
+                ends.push_back((uint32_t) names.size());
+                local = (uint32_t) ends.size();
+            }
+            values.push_back((int32_t) local);
+        } else if (hasValue(token.getType())) {
+            values.push_back(token.getValue());
+        }
+    }
+    CacheHeader header;
+    memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.hash = hash;
+    header.sourceSize = (uint64_t) (end_ - begin_);
+    header.tokenCount = (uint32_t) records.size();
+    header.valueCount = (uint32_t) values.size();
+    header.identCount = (uint32_t) ends.size();
+    header.namesSize = (uint32_t) names.size();
+
+    // the file is written under a temporary name and renamed, so that a concurrent compiler never reads half of it
+    const std::string temp = path + "." + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+    std::ofstream out(temp, std::ios::out | std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(records.data()), (std::streamsize) (records.size() * sizeof(CacheToken)));
+    out.write(reinterpret_cast<const char*>(values.data()), (std::streamsize) (values.size() * sizeof(int32_t)));
+    out.write(reinterpret_cast<const char*>(ends.data()), (std::streamsize) (ends.size() * sizeof(uint32_t)));
+    out.write(names.data(), (std::streamsize) names.size());
+    out.close();
+    if (!out || std::rename(temp.c_str(), path.c_str()) != 0) {
+        std::remove(temp.c_str());
+        logger_->debug(filename_.c_str(), "Cannot write token cache ", path, ".");
+    }
+}
@@ -0,0 +1,47 @@
+/*
+ * Implementation of the arena used by the Oberon-0 compiler.
+ */
+
+#include <cstdint>
+#include "Arena.h"
+
+const size_t Arena::BLOCK_SIZE;
+
+Arena::Arena() : cur_(nullptr), end_(nullptr), size_(0) {
+}
+
+Arena::~Arena() {
+    for (auto cleanup = cleanups_.rbegin(); cleanup != cleanups_.rend(); ++cleanup) {
+        cleanup->destroy(cleanup->object);
+    }
+}
+
+void *Arena::allocate(const size_t size, const size_t alignment) {
+    const uintptr_t address = ((uintptr_t) cur_ + alignment - 1) & ~(uintptr_t) (alignment - 1);
+    if (cur_ == nullptr || address + size > (uintptr_t) end_) {
+        return allocateBlock(size, alignment);
+    }
+    cur_ = (char*) (address + size);
+    size_ += size;
+    return (void*) address;
+}
+
+void *Arena::allocateBlock(const size_t size, const size_t alignment) {
+    // blocks are aligned for any fundamental type, so only stricter alignments need extra room
+    const size_t padding = (alignment > alignof(std::max_align_t)) ? alignment : 0;
+    if (size + padding > BLOCK_SIZE / 4) {
+        // a large object gets a block of its own, so that the rest of the current block is not wasted
+        blocks_.emplace_back(new char[size + padding]);
+        const uintptr_t address = ((uintptr_t) blocks_.back().get() + alignment - 1) & ~(uintptr_t) (alignment - 1);
+        size_ += size;
+        return (void*) address;
+    }
+    blocks_.emplace_back(new char[BLOCK_SIZE]);
+    cur_ = blocks_.back().get();
+    end_ = cur_ + BLOCK_SIZE;
+    return allocate(size, alignment);
+}
+
+const size_t Arena::size() const {
+    return size_;
+}
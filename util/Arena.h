@@ -0,0 +1,72 @@
+/*
+ * Header file of the arena used by the Oberon-0 compiler.
+ *
+ * An arena hands out memory from large blocks by bumping a pointer and frees all of it at once when it is
+ * destroyed. Objects created in the arena are never destroyed individually: their destructors are run in
+ * reverse order of creation when the arena is destroyed, and not at all if they are trivially destructible.
+ * Pointers to objects in the arena are thus valid for as long as the arena exists.
+ */
+
+#ifndef OBERON0C_ARENA_H
+#define OBERON0C_ARENA_H
+
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class Arena {
+
+private:
+    struct Cleanup {
+        void (*destroy)(void *object);
+        void *object;
+    };
+
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char *cur_, *end_;
+    std::vector<Cleanup> cleanups_;
+    size_t size_;
+
+    void *allocateBlock(size_t size, size_t alignment);
+
+    template <typename T>
+    static void destroy(void *object);
+
+public:
+    // size of the blocks that objects are allocated from; larger objects get a block of their own
+    static const size_t BLOCK_SIZE = 64 * 1024;
+
+    explicit Arena();
+    Arena(const Arena &) = delete;
+    Arena& operator=(const Arena &) = delete;
+    ~Arena();
+
+    void *allocate(size_t size, size_t alignment);
+    template <typename T, typename... Args>
+    T *create(Args &&... args);
+
+    // number of bytes handed out so far
+    const size_t size() const;
+
+};
+
+template <typename T>
+void Arena::destroy(void *object) {
+    static_cast<T*>(object)->~T();
+}
+
+template <typename T, typename... Args>
+T *Arena::create(Args &&... args) {
+    T *object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    if (!std::is_trivially_destructible<T>::value) {
+        cleanups_.push_back({ destroy<T>, object });
+    }
+    return object;
+}
+
+
+#endif //OBERON0C_ARENA_H
@@ -0,0 +1,176 @@
+/*
+ * Implementation of the asynchronous mode of the logger used by the Oberon-0 compiler.
+ *
+ * In asynchronous mode, logging a message copies it into a fixed-size record of a bounded ring buffer, and a
+ * background thread formats and writes the records in batches. The output streams are flushed once per batch
+ * instead of once per message, and whenever the output switches between the two streams, so that messages
+ * also come out in order if both streams go to the same terminal.
+ *
+ * Any number of threads can log at the same time without taking a lock. A thread claims a record by advancing
+ * the enqueue position with a compare-and-swap, and publishes it by setting the sequence number of the record,
+ * which the writer waits for (Vyukov's bounded queue). If the queue is full, the thread waits for the writer.
+ * The writer wakes up periodically, and a logging thread only wakes it up early once the queue is half full,
+ * so that the writer handles messages in batches instead of competing with the logging threads for every
+ * one of them. Loggers in asynchronous mode are flushed when the program exits, also if it exits through
+ * exit().
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include "Logger.h"
+
+static const size_t LOG_QUEUE_SIZE = 1024;
+static const size_t LOG_TEXT_SIZE = 488;
+// how long the writer sleeps while the queue is less than half full
+static const std::chrono::milliseconds LOG_WRITE_INTERVAL(5);
+
+struct LogRecord {
+    std::atomic<size_t> sequence;
+    LogLevel level;
+    int lineNo, charNo;
+    unsigned short nameLength, msgLength;
+    // the file name followed by the message, which is cut off if both do not fit
+    char text[LOG_TEXT_SIZE];
+};
+
+struct LogQueue {
+    LogRecord records[LOG_QUEUE_SIZE];
+    std::atomic<size_t> enqueued;
+    // only used by the writer
+    size_t dequeued;
+    std::atomic<size_t> written;
+    std::atomic<bool> requested, stopped;
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::ostream *out, *err;
+    std::thread writer;
+};
+
+static void wake(LogQueue &queue) {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.requested.store(true);
+    queue.wakeup.notify_one();
+}
+
+static bool published(LogQueue &queue) {
+    const LogRecord &record = queue.records[queue.dequeued & (LOG_QUEUE_SIZE - 1)];
+    return record.sequence.load(std::memory_order_acquire) == queue.dequeued + 1;
+}
+
+void Logger::enqueue(const LogLevel level, const std::string &fileName, const int lineNo, const int charNo,
+                     const std::string &msg) const {
+    LogQueue &queue = *queue_;
+    size_t pos = queue.enqueued.load(std::memory_order_relaxed);
+    LogRecord *record;
+    while (true) {
+        record = &queue.records[pos & (LOG_QUEUE_SIZE - 1)];
+        const size_t sequence = record->sequence.load(std::memory_order_acquire);
+        if (sequence == pos) {
+            if (queue.enqueued.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (sequence < pos) {
+            // the queue is full, so the writer has to catch up first
+            wake(queue);
+            std::this_thread::yield();
+            pos = queue.enqueued.load(std::memory_order_relaxed);
+        } else {
+            pos = queue.enqueued.load(std::memory_order_relaxed);
+        }
+    }
+    record->level = level;
+    record->lineNo = lineNo;
+    record->charNo = charNo;
+    const size_t nameLength = std::min(fileName.size(), LOG_TEXT_SIZE / 2);
+    const size_t msgLength = std::min(msg.size(), LOG_TEXT_SIZE - nameLength);
+    memcpy(record->text, fileName.data(), nameLength);
+    memcpy(record->text + nameLength, msg.data(), msgLength);
+    record->nameLength = (unsigned short) nameLength;
+    record->msgLength = (unsigned short) msgLength;
+    record->sequence.store(pos + 1, std::memory_order_release);
+    if (pos + 1 - queue.written.load(std::memory_order_relaxed) >= LOG_QUEUE_SIZE / 2 &&
+        !queue.requested.load(std::memory_order_relaxed)) {
+        wake(queue);
+    }
+}
+
+void Logger::write(LogQueue *queue) {
+    while (true) {
+        std::ostream *current = nullptr;
+        while (published(*queue)) {
+            LogRecord &record = queue->records[queue->dequeued & (LOG_QUEUE_SIZE - 1)];
+            std::ostream *out = (record.level == LogLevel::ERROR) ? queue->err : queue->out;
+            if (current != nullptr && current != out) {
+                current->flush();
+            }
+            current = out;
+            format(*out, record.level, record.text, record.nameLength, record.lineNo, record.charNo,
+                   record.text + record.nameLength, record.msgLength);
+            *out << '\n';
+            record.sequence.store(queue->dequeued + LOG_QUEUE_SIZE, std::memory_order_release);
+            queue->dequeued++;
+        }
+        if (current != nullptr) {
+            current->flush();
+            queue->written.store(queue->dequeued, std::memory_order_release);
+            continue;
+        }
+        if (queue->stopped.load()) {
+            break;
+        }
+        std::unique_lock<std::mutex> lock(queue->mutex);
+        queue->wakeup.wait_for(lock, LOG_WRITE_INTERVAL, [queue]() {
+            return queue->requested.load() || queue->stopped.load();
+        });
+        queue->requested.store(false);
+    }
+}
+
+void Logger::setAsync(const bool async) {
+    if (async && queue_ == nullptr) {
+        queue_ = new LogQueue();
+        for (size_t i = 0; i < LOG_QUEUE_SIZE; i++) {
+            queue_->records[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        queue_->enqueued.store(0);
+        queue_->dequeued = 0;
+        queue_->written.store(0);
+        queue_->requested.store(false);
+        queue_->stopped.store(false);
+        queue_->out = out_;
+        queue_->err = err_;
+        queue_->writer = std::thread(write, queue_);
+        watch(this, true);
+    } else if (!async && queue_ != nullptr) {
+        flush();
+        queue_->stopped.store(true);
+        wake(*queue_);
+        queue_->writer.join();
+        delete queue_;
+        queue_ = nullptr;
+        watch(this, sink_ != nullptr);
+    }
+}
+
+const bool Logger::isAsync() const {
+    return queue_ != nullptr;
+}
+
+void Logger::flush() const {
+    if (queue_ == nullptr) {
+        out_->flush();
+        err_->flush();
+        return;
+    }
+    // waits until the messages that have been logged so far are written
+    const size_t target = queue_->enqueued.load();
+    while (queue_->written.load(std::memory_order_acquire) < target) {
+        wake(*queue_);
+        std::this_thread::yield();
+    }
+}
@@ -0,0 +1,163 @@
+/*
+ * Implementation of the structured diagnostics of the logger used by the Oberon-0 compiler.
+ *
+ * Every message that the logger writes is also recorded with its severity, a category, a code, the position
+ * in the source and the arguments that were substituted into it. The records and their text are kept in
+ * buffers that are allocated once, so recording a message is a few appends, and all records are written as
+ * JSON lines in one go when diagnostics are switched off, the logger is destroyed, or the program exits.
+ *
+ * The code of a message is a hash of its text with the arguments replaced by placeholders, so that all
+ * messages of the same kind share a code, whichever identifier or value they mention.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include "Logger.h"
+
+struct Diagnostic {
+    LogLevel level;
+    uint32_t code;
+    FilePos pos;
+    int lineNo, charNo;
+    // ranges in the text buffer of the sink
+    size_t name, nameLength, message, messageLength;
+    // range in the arguments of the sink
+    size_t args, argCount;
+};
+
+struct DiagnosticSink {
+    std::ostream *out;
+    std::vector<Diagnostic> records;
+    // offset and length of every argument in the text buffer
+    std::vector<std::pair<size_t, size_t>> args;
+    std::string text;
+};
+
+static const size_t INITIAL_DIAGNOSTICS = 256;
+static const size_t INITIAL_DIAGNOSTICS_TEXT = 64 * 1024;
+
+static const char *SYNTAX_ERROR = "- SYNTAX ERROR";
+static const char *SEMANTIC_ERROR = "- SEMANTIC ERROR";
+
+static uint32_t hashPattern(const std::string &pattern) {
+    uint32_t hash = 2166136261u;
+    for (const char ch : pattern) {
+        hash = (hash ^ (unsigned char) ch) * 16777619u;
+    }
+    return hash;
+}
+
+static const char *category(const std::string &text, const size_t offset) {
+    if (text.compare(offset, strlen(SYNTAX_ERROR), SYNTAX_ERROR) == 0) {
+        return "syntax";
+    } else if (text.compare(offset, strlen(SEMANTIC_ERROR), SEMANTIC_ERROR) == 0) {
+        return "semantic";
+    }
+    return "general";
+}
+
+static void quote(std::ostream &out, const char *text, const size_t length) {
+    out << '"';
+    for (size_t i = 0; i < length; i++) {
+        const char ch = text[i];
+        switch (ch) {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n";  break;
+            case '\r': out << "\\r";  break;
+            case '\t': out << "\\t";  break;
+            default:
+                if ((unsigned char) ch < 0x20) {
+                    char escape[7];
+                    snprintf(escape, sizeof(escape), "\\u%04x", (unsigned int) (unsigned char) ch);
+                    out << escape;
+                } else {
+                    out << ch;
+                }
+        }
+    }
+    out << '"';
+}
+
+void Logger::record(const LogLevel level, const FilePos pos, const std::string &fileName, const int lineNo,
+                    const int charNo, const std::string &msg, const std::string &pattern,
+                    const std::vector<std::string> *args) const {
+    DiagnosticSink &sink = *sink_;
+    Diagnostic diagnostic;
+    diagnostic.level = level;
+    diagnostic.code = hashPattern(pattern);
+    diagnostic.pos = pos;
+    diagnostic.lineNo = lineNo;
+    diagnostic.charNo = charNo;
+    const std::string &name = (pos.fileId != FileTable::NO_FILE) ? FileTable::instance().getName(pos.fileId) : fileName;
+    diagnostic.name = sink.text.size();
+    diagnostic.nameLength = name.size();
+    sink.text += name;
+    diagnostic.message = sink.text.size();
+    diagnostic.messageLength = msg.size();
+    sink.text += msg;
+    diagnostic.args = sink.args.size();
+    diagnostic.argCount = 0;
+    if (args != nullptr) {
+        for (auto &arg : *args) {
+            sink.args.emplace_back(sink.text.size(), arg.size());
+            sink.text += arg;
+        }
+        diagnostic.argCount = args->size();
+    }
+    sink.records.push_back(diagnostic);
+}
+
+void Logger::writeDiagnostics() const {
+    DiagnosticSink &sink = *sink_;
+    std::ostream &out = *sink.out;
+    const char *text = sink.text.data();
+    for (auto &diagnostic : sink.records) {
+        out << "{\"severity\":";
+        switch (diagnostic.level) {
+            case LogLevel::DEBUG: out << "\"debug\""; break;
+            case LogLevel::INFO:  out << "\"info\"";  break;
+            case LogLevel::ERROR: out << "\"error\""; break;
+        }
+        char code[9];
+        snprintf(code, sizeof(code), "%08x", diagnostic.code);
+        out << ",\"category\":\"" << category(sink.text, diagnostic.message) << "\",\"code\":\"" << code << "\"";
+        out << ",\"fileId\":" << diagnostic.pos.fileId << ",\"file\":";
+        quote(out, text + diagnostic.name, diagnostic.nameLength);
+        if (diagnostic.pos.fileId != FileTable::NO_FILE) {
+            out << ",\"offset\":" << diagnostic.pos.offset;
+            out << ",\"line\":" << diagnostic.lineNo << ",\"column\":" << diagnostic.charNo;
+        }
+        out << ",\"message\":";
+        quote(out, text + diagnostic.message, diagnostic.messageLength);
+        out << ",\"args\":[";
+        for (size_t i = 0; i < diagnostic.argCount; i++) {
+            const auto &arg = sink.args[diagnostic.args + i];
+            if (i > 0) {
+                out << ",";
+            }
+            quote(out, text + arg.first, arg.second);
+        }
+        out << "]}\n";
+    }
+    out.flush();
+}
+
+void Logger::setDiagnostics(std::ostream *out) {
+    if (out != nullptr && sink_ == nullptr) {
+        sink_ = new DiagnosticSink();
+        sink_->records.reserve(INITIAL_DIAGNOSTICS);
+        sink_->text.reserve(INITIAL_DIAGNOSTICS_TEXT);
+        sink_->out = out;
+        watch(this, true);
+    } else if (out != nullptr) {
+        sink_->out = out;
+    } else if (sink_ != nullptr) {
+        // messages still in the queue have already been recorded, so the records can be written right away
+        writeDiagnostics();
+        delete sink_;
+        sink_ = nullptr;
+        watch(this, queue_ != nullptr);
+    }
+}
@@ -0,0 +1,113 @@
+/*
+ * Implementation of the file table used by the Oberon-0 compiler.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include "FileTable.h"
+
+const unsigned int FileTable::NO_FILE;
+
+FileTable::FileTable() : files_(), mutex_() {
+}
+
+FileTable::~FileTable() = default;
+
+FileTable& FileTable::instance() {
+    static FileTable table;
+    return table;
+}
+
+unsigned int FileTable::add(const std::string &name, const char *data, size_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    files_.push_back({ name, data, size, false, {} });
+    // file ids start at one, so that a zero-initialized position refers to no file
+    return (unsigned int) files_.size();
+}
+
+void FileTable::update(unsigned int fileId, const char *data, size_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fileId == NO_FILE || fileId > files_.size()) {
+        return;
+    }
+    // the source text has been edited, so the line table is rebuilt when it is needed next
+    Entry &entry = files_[fileId - 1];
+    entry.data = data;
+    entry.size = size;
+    entry.hasLines = false;
+}
+
+void FileTable::append(unsigned int fileId, const char *data, size_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fileId == NO_FILE || fileId > files_.size()) {
+        return;
+    }
+    // the text of a streamed file is not kept, so its line table is extended whenever a block is read
+    Entry &entry = files_[fileId - 1];
+    if (!entry.hasLines) {
+        buildLines(entry);
+    }
+    const char *end = data + size;
+    const char *p = data;
+    while ((p = static_cast<const char*>(memchr(p, '\n', (size_t) (end - p)))) != nullptr) {
+        p++;
+        entry.lineStarts.push_back((unsigned int) (entry.size + (size_t) (p - data)));
+    }
+    entry.size += size;
+}
+
+void FileTable::release(unsigned int fileId) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fileId == NO_FILE || fileId > files_.size()) {
+        return;
+    }
+    // the source text is about to go away, so positions must be resolvable without it
+    Entry &entry = files_[fileId - 1];
+    if (!entry.hasLines) {
+        buildLines(entry);
+    }
+    entry.data = nullptr;
+}
+
+void FileTable::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    files_.clear();
+}
+
+const std::string FileTable::getName(unsigned int fileId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fileId == NO_FILE || fileId > files_.size()) {
+        return "";
+    }
+    return files_[fileId - 1].name;
+}
+
+bool FileTable::resolve(FilePos pos, int &lineNo, int &charNo) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pos.fileId == NO_FILE || pos.fileId > files_.size()) {
+        return false;
+    }
+    Entry &entry = files_[pos.fileId - 1];
+    if (!entry.hasLines) {
+        buildLines(entry);
+    }
+    auto it = std::upper_bound(entry.lineStarts.begin(), entry.lineStarts.end(), pos.offset);
+    lineNo = (int) (it - entry.lineStarts.begin());
+    charNo = (int) (pos.offset - *(it - 1)) + 1;
+    return true;
+}
+
+void FileTable::buildLines(Entry &entry) {
+    entry.lineStarts.clear();
+    entry.lineStarts.push_back(0);
+    if (entry.data) {
+        const char *begin = entry.data;
+        const char *end = entry.data + entry.size;
+        const char *p = begin;
+        while ((p = static_cast<const char*>(memchr(p, '\n', (size_t) (end - p)))) != nullptr) {
+            p++;
+            entry.lineStarts.push_back((unsigned int) (p - begin));
+        }
+    }
+    entry.hasLines = true;
+}
@@ -0,0 +1,68 @@
+/*
+ * Header file of the file table used by the Oberon-0 compiler.
+ *
+ * Source positions are encoded compactly as a file id and a byte offset (see FilePos). The file
+ * table maps file ids back to file names and recovers line and column numbers from offsets. The
+ * line table of a file is only built the first time a position in that file has to be resolved,
+ * i.e., when a diagnostic is actually reported.
+ *
+ * The table is global, as positions are resolved wherever a diagnostic is reported, e.g., by the logger,
+ * long after the scanner that created them is gone, and a position has no room for a pointer to its table.
+ * Once the source text of a file is released, its entry only keeps the name and the line table, so a
+ * compiler that translates one module per process never drops it. A process that runs compilation after
+ * compilation owns the table per compilation and clears it once nothing refers to the positions any more.
+ */
+
+#ifndef OBERON0C_FILETABLE_H
+#define OBERON0C_FILETABLE_H
+
+
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct FilePos {
+    unsigned int fileId;
+    unsigned int offset;
+};
+
+class FileTable {
+
+private:
+    struct Entry {
+        std::string name;
+        const char *data;
+        size_t size;
+        bool hasLines;
+        std::vector<unsigned int> lineStarts;
+    };
+
+    std::deque<Entry> files_;
+    mutable std::mutex mutex_;
+
+    static void buildLines(Entry &entry);
+
+public:
+    static const unsigned int NO_FILE = 0;
+
+    explicit FileTable();
+    ~FileTable();
+
+    static FileTable& instance();
+
+    unsigned int add(const std::string &name, const char *data, size_t size);
+    void update(unsigned int fileId, const char *data, size_t size);
+    void append(unsigned int fileId, const char *data, size_t size);
+    void release(unsigned int fileId);
+    // drops all files, which invalidates the positions in all of them
+    void clear();
+
+    const std::string getName(unsigned int fileId) const;
+    bool resolve(FilePos pos, int &lineNo, int &charNo);
+
+};
+
+
+#endif //OBERON0C_FILETABLE_H
@@ -0,0 +1,122 @@
+/*
+ * Implementation of the interned identifiers used by the Oberon-0 compiler.
+ */
+
+#include <cstring>
+#include "Ident.h"
+
+const unsigned int Ident::NONE;
+
+Ident::Ident() : id_(NONE) {
+}
+
+Ident::Ident(unsigned int id) : id_(id) {
+}
+
+const unsigned int Ident::getId() const {
+    return id_;
+}
+
+const bool Ident::empty() const {
+    return id_ == NONE;
+}
+
+const std::string& Ident::getName() const {
+    return IdentTable::instance().getName(*this);
+}
+
+bool Ident::operator==(const Ident &other) const {
+    return id_ == other.id_;
+}
+
+bool Ident::operator!=(const Ident &other) const {
+    return id_ != other.id_;
+}
+
+std::ostream& operator<<(std::ostream &stream, const Ident &ident) {
+    stream << ident.getName();
+    return stream;
+}
+
+IdentTable::IdentTable() : names_(), hashes_(), slots_(1024, Ident::NONE), mask_(1023) {
+    // id 0 is the empty identifier
+    names_.emplace_back();
+    hashes_.push_back(0);
+}
+
+IdentTable::~IdentTable() = default;
+
+IdentTable& IdentTable::instance() {
+    static IdentTable table;
+    return table;
+}
+
+unsigned int IdentTable::hash(const char *text, size_t length) {
+    // FNV-1a
+    unsigned int h = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        h = (h ^ (unsigned char) text[i]) * 16777619u;
+    }
+    return h;
+}
+
+const Ident IdentTable::intern(const char *text, size_t length) {
+    if (length == 0) {
+        return Ident();
+    }
+    const unsigned int h = hash(text, length);
+    size_t slot = h & mask_;
+    while (slots_[slot] != Ident::NONE) {
+        const unsigned int id = slots_[slot];
+        if ((hashes_[id] == h) && (names_[id].size() == length) && (memcmp(names_[id].data(), text, length) == 0)) {
+            return Ident(id);
+        }
+        slot = (slot + 1) & mask_;
+    }
+    const unsigned int id = (unsigned int) names_.size();
+    names_.emplace_back(text, length);
+    hashes_.push_back(h);
+    slots_[slot] = id;
+    // keep the load factor below one half
+    if (2 * names_.size() > slots_.size()) {
+        grow();
+    }
+    return Ident(id);
+}
+
+const Ident IdentTable::intern(const std::string &name) {
+    return intern(name.data(), name.size());
+}
+
+const std::string& IdentTable::getName(Ident ident) const {
+    if (ident.getId() >= names_.size()) {
+        return names_[Ident::NONE];
+    }
+    return names_[ident.getId()];
+}
+
+const size_t IdentTable::size() const {
+    return names_.size() - 1;
+}
+
+void IdentTable::clear() {
+    names_.resize(1);
+    hashes_.resize(1);
+    slots_.assign(1024, Ident::NONE);
+    slots_.shrink_to_fit();
+    mask_ = 1023;
+}
+
+void IdentTable::grow() {
+    std::vector<unsigned int> slots(2 * slots_.size(), Ident::NONE);
+    const size_t mask = slots.size() - 1;
+    for (unsigned int id = 1; id < names_.size(); id++) {
+        size_t slot = hashes_[id] & mask;
+        while (slots[slot] != Ident::NONE) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = id;
+    }
+    slots_.swap(slots);
+    mask_ = mask;
+}
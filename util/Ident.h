@@ -0,0 +1,73 @@
+/*
+ * Header file of the interned identifiers used by the Oberon-0 compiler.
+ *
+ * Every distinct identifier is assigned a stable 32-bit id by the identifier table when it is first
+ * scanned. The scanner, the parser and the symbol table only pass these ids around, so that comparing
+ * or hashing identifiers is an integer operation. Id 0 is reserved for "no identifier".
+ *
+ * The table is global, as an id is all that tokens, the AST and diagnostics keep of an identifier, and
+ * its name is looked up wherever it is printed. It grows with the number of distinct identifiers, which is
+ * small for the modules of one compilation, so a compiler that translates one module per process never
+ * drops it. A process that runs compilation after compilation owns the table per compilation and clears
+ * it once nothing refers to the ids any more.
+ */
+
+#ifndef OBERON0C_IDENT_H
+#define OBERON0C_IDENT_H
+
+
+#include <cstddef>
+#include <deque>
+#include <ostream>
+#include <string>
+#include <vector>
+
+class Ident {
+
+private:
+    unsigned int id_;
+
+public:
+    static const unsigned int NONE = 0;
+
+    Ident();
+    explicit Ident(unsigned int id);
+
+    const unsigned int getId() const;
+    const bool empty() const;
+    const std::string& getName() const;
+
+    bool operator==(const Ident &other) const;
+    bool operator!=(const Ident &other) const;
+    friend std::ostream& operator<<(std::ostream &stream, const Ident &ident);
+
+};
+
+class IdentTable {
+
+private:
+    std::deque<std::string> names_;
+    std::vector<unsigned int> hashes_;
+    std::vector<unsigned int> slots_;
+    size_t mask_;
+
+    static unsigned int hash(const char *text, size_t length);
+    void grow();
+
+public:
+    explicit IdentTable();
+    ~IdentTable();
+
+    static IdentTable& instance();
+
+    const Ident intern(const char *text, size_t length);
+    const Ident intern(const std::string &name);
+    const std::string& getName(Ident ident) const;
+    const size_t size() const;
+    // drops all identifiers, which invalidates all ids
+    void clear();
+
+};
+
+
+#endif //OBERON0C_IDENT_H
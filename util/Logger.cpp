@@ -4,61 +4,158 @@
  * Created by Michael Grossniklaus on 2/8/18.
  */
 
+#include <algorithm>
+#include <cstdlib>
 #include <iomanip>
+#include <mutex>
 #include "Logger.h"
 
 Logger::Logger() : Logger(LogLevel::ERROR, &std::cout, &std::cerr) {
 }
 
-Logger::Logger(LogLevel level, std::ostream *out, std::ostream *err) : level_(level), out_(out), err_(err) {
+Logger::Logger(LogLevel level, std::ostream *out, std::ostream *err) :
+        level_(level), out_(out), err_(err), queue_(nullptr), sink_(nullptr) {
 }
 
-Logger::~Logger() = default;
+Logger::~Logger() {
+    setAsync(false);
+    setDiagnostics(nullptr);
+}
+
+// loggers that write messages in the background or collect diagnostics, which are flushed when the program exits
+static std::mutex &registryMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+static std::vector<Logger*> &registry() {
+    static std::vector<Logger*> loggers;
+    return loggers;
+}
+
+void Logger::watch(Logger *logger, const bool watched) {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    auto &loggers = registry();
+    static bool registered = false;
+    if (!registered) {
+        // registered after the registry has been constructed, so that it is still alive at exit
+        std::atexit(flushAll);
+        registered = true;
+    }
+    const auto it = std::find(loggers.begin(), loggers.end(), logger);
+    if (watched && it == loggers.end()) {
+        loggers.push_back(logger);
+    } else if (!watched && it != loggers.end()) {
+        loggers.erase(it);
+    }
+}
+
+void Logger::flushAll() {
+    std::vector<Logger*> loggers;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        loggers = registry();
+    }
+    for (auto logger : loggers) {
+        logger->setAsync(false);
+        logger->setDiagnostics(nullptr);
+    }
+}
+
+void Logger::format(std::ostream &out, const LogLevel level, const char *fileName, const size_t nameLength,
+                    const int lineNo, const int charNo, const char *msg, const size_t msgLength) {
+    if (nameLength > 0) {
+        out.write(fileName, (std::streamsize) nameLength);
+        if (lineNo >= 0) {
+            out << ":" << lineNo;
+            if (charNo >= 0) {
+                out << ":" << charNo;
+            }
+        }
+        out << ": ";
+    }
+    out << "[" << std::setw(5);
+    switch (level) {
+        case LogLevel::DEBUG: out << "DEBUG"; break;
+        case LogLevel::INFO:  out << "INFO";  break;
+        case LogLevel::ERROR: out << "ERROR"; break;
+    }
+    out << "] ";
+    out.write(msg, (std::streamsize) msgLength);
+}
 
 void Logger::log(const LogLevel level, const std::string &fileName, int lineNo, int charNo,
                  const std::string &msg) const {
     if (level >= level_) {
-        std::ostream *out = (level == LogLevel::ERROR) ? err_ : out_;
-        if (!fileName.empty()) {
-            *out << fileName;
-            if (lineNo >= 0) {
-                *out << ":" << lineNo;
-                if (charNo >= 0) {
-                    *out << ":" << charNo;
-                }
+        if (queue_ != nullptr) {
+            enqueue(level, fileName, lineNo, charNo, msg);
+            if (level == LogLevel::ERROR) {
+                // errors are written right away, so that they are not lost if the program crashes
+                flush();
             }
-            *out << ": ";
-        }
-        *out << "[" << std::setw(5);
-        switch (level) {
-            case LogLevel::DEBUG: *out << "DEBUG"; break;
-            case LogLevel::INFO:  *out << "INFO";  break;
-            case LogLevel::ERROR: *out << "ERROR"; break;
+            return;
         }
-        *out << "] " << msg << std::endl;
+        std::ostream *out = (level == LogLevel::ERROR) ? err_ : out_;
+        format(*out, level, fileName.data(), fileName.size(), lineNo, charNo, msg.data(), msg.size());
+        *out << std::endl;
     }
 }
 
-void Logger::log(const LogLevel level, const std::string &fileName, const std::string &msg) const {
-    log(level, fileName, -1, -1, msg);
+void Logger::report(const LogLevel level, const FilePos pos, const std::string &fileName, const std::string &msg,
+                    const std::string *pattern, const std::vector<std::string> *args) const {
+    if (level >= level_) {
+        int lineNo = -1, charNo = -1;
+        if (pos.fileId != FileTable::NO_FILE) {
+            // line and column are only recovered from the offset when the message is actually written
+            FileTable &files = FileTable::instance();
+            files.resolve(pos, lineNo, charNo);
+            log(level, files.getName(pos.fileId), lineNo, charNo, msg);
+        } else {
+            log(level, fileName, lineNo, charNo, msg);
+        }
+        if (sink_ != nullptr) {
+            record(level, pos, fileName, lineNo, charNo, msg, (pattern != nullptr) ? *pattern : msg, args);
+        }
+    }
 }
 
 void Logger::error(const FilePos pos, const std::string &msg) const {
-    log(LogLevel::ERROR, pos.fileName, pos.lineNo, pos.charNo, msg);
+    report(LogLevel::ERROR, pos, std::string(), msg);
 }
 
 void Logger::error(const std::string &fileName, const std::string &msg) const {
-    log(LogLevel::ERROR, fileName, msg);
+    report(LogLevel::ERROR, { FileTable::NO_FILE, 0 }, fileName, msg);
 }
 
 void Logger::info(const std::string &fileName, const std::string &msg) const {
-    log(LogLevel::INFO, fileName, msg);
+    report(LogLevel::INFO, { FileTable::NO_FILE, 0 }, fileName, msg);
 }
 
 void Logger::debug(const std::string &fileName, const std::string &msg) const {
-    log(LogLevel::DEBUG, fileName, msg);
+    report(LogLevel::DEBUG, { FileTable::NO_FILE, 0 }, fileName, msg);
 }
 
 void Logger::setLevel(LogLevel level) {
     level_ = level;
 }
+
+const bool Logger::isEnabled(const LogLevel level) const {
+    return level >= level_;
+}
+
+void Logger::append(std::string &text, const std::string &part) {
+    text += part;
+}
+
+void Logger::append(std::string &text, const char *part) {
+    text += part;
+}
+
+void Logger::split(std::string &pattern, std::vector<std::string> &args, const std::string &part) {
+    pattern += "{}";
+    args.push_back(part);
+}
+
+void Logger::split(std::string &pattern, std::vector<std::string> &, const char *part) {
+    pattern += part;
+}
@@ -9,27 +9,67 @@
 #include <string>
 #include <iostream>
 #include <sstream>
-
-struct FilePos {
-    std::string fileName;
-    int lineNo, charNo;
-};
+#include <vector>
+#include "FileTable.h"
 
 enum class LogLevel : unsigned int { DEBUG = 1, INFO = 2, ERROR = 3 };
 
+/*
+ * Messages can also be written by a background thread (see setAsync), in which case logging a message only
+ * copies it into a queue. Messages are written in the order in which they were logged, and all messages are
+ * written before the program exits.
+ */
+struct LogQueue;
+
+/*
+ * Besides the text output, messages can be recorded as structured diagnostics (see setDiagnostics), which are
+ * written as JSON lines when the logger is destroyed or the program exits.
+ */
+struct DiagnosticSink;
+
 class Logger
 {
 
 private:
     LogLevel level_;
     std::ostream *out_, *err_;
+    // the queue of the background thread, or nullptr if messages are written directly
+    LogQueue *queue_;
+    // the sink of the structured diagnostics, or nullptr if messages are only written as text
+    DiagnosticSink *sink_;
 
+    static void format(std::ostream &out, LogLevel level, const char *fileName, size_t nameLength,
+                       int lineNo, int charNo, const char *msg, size_t msgLength);
+    static void write(LogQueue *queue);
+    static void watch(Logger *logger, bool watched);
+    static void flushAll();
+    void enqueue(LogLevel level, const std::string &fileName, int lineNo, int charNo, const std::string &msg) const;
     void log(LogLevel level, const std::string &fileName, int lineNo, int charNo, const std::string &msg) const;
-    void log(LogLevel level, const std::string &fileName, const std::string &msg) const;
+    void report(LogLevel level, FilePos pos, const std::string &fileName, const std::string &msg,
+                const std::string *pattern = nullptr, const std::vector<std::string> *args = nullptr) const;
+    void record(LogLevel level, FilePos pos, const std::string &fileName, int lineNo, int charNo,
+                const std::string &msg, const std::string &pattern, const std::vector<std::string> *args) const;
+    void writeDiagnostics() const;
+
+    static void append(std::string &text, const std::string &part);
+    static void append(std::string &text, const char *part);
+    template <typename T>
+    static void append(std::string &text, const T &part);
+    template <typename... Parts>
+    static std::string concat(const Parts &... parts);
+    // splits the parts of a message into the literal text with placeholders and the arguments
+    static void split(std::string &pattern, std::vector<std::string> &args, const std::string &part);
+    static void split(std::string &pattern, std::vector<std::string> &args, const char *part);
+    template <typename T>
+    static void split(std::string &pattern, std::vector<std::string> &args, const T &part);
+    template <typename... Parts>
+    void reportParts(LogLevel level, FilePos pos, const char *fileName, const Parts &... parts) const;
 
 public:
     explicit Logger();
     explicit Logger(LogLevel level, std::ostream *out, std::ostream *err);
+    Logger(const Logger &) = delete;
+    Logger& operator=(const Logger &) = delete;
     ~Logger();
 
     void error(FilePos pos, const std::string &msg) const;
@@ -37,7 +77,20 @@ public:
     void info(const std::string &fileName, const std::string &msg) const;
     void debug(const std::string &fileName, const std::string &msg) const;
 
+    // the parts of the message are only converted and concatenated if the message is actually logged
+    template <typename... Parts>
+    void error(FilePos pos, const Parts &... parts) const;
+    template <typename... Parts>
+    void info(const char *fileName, const Parts &... parts) const;
+    template <typename... Parts>
+    void debug(const char *fileName, const Parts &... parts) const;
+    const bool isEnabled(LogLevel level) const;
+
     void setLevel(LogLevel level);
+    void setAsync(bool async);
+    const bool isAsync() const;
+    void flush() const;
+    void setDiagnostics(std::ostream *out);
 
 };
 
@@ -48,5 +101,54 @@ static std::string to_string(T obj) {
     return stream.str();
 }
 
+template <typename T>
+void Logger::append(std::string &text, const T &part) {
+    text += to_string(part);
+}
+
+template <typename... Parts>
+std::string Logger::concat(const Parts &... parts) {
+    std::string text;
+    const int expand[] = { 0, (append(text, parts), 0)... };
+    (void) expand;
+    return text;
+}
+
+template <typename T>
+void Logger::split(std::string &pattern, std::vector<std::string> &args, const T &part) {
+    pattern += "{}";
+    args.push_back(to_string(part));
+}
+
+template <typename... Parts>
+void Logger::reportParts(const LogLevel level, const FilePos pos, const char *fileName, const Parts &... parts) const {
+    if (level >= level_) {
+        if (sink_ == nullptr) {
+            report(level, pos, fileName, concat(parts...));
+        } else {
+            std::string pattern;
+            std::vector<std::string> args;
+            const int expand[] = { 0, (split(pattern, args, parts), 0)... };
+            (void) expand;
+            report(level, pos, fileName, concat(parts...), &pattern, &args);
+        }
+    }
+}
+
+template <typename... Parts>
+void Logger::error(const FilePos pos, const Parts &... parts) const {
+    reportParts(LogLevel::ERROR, pos, "", parts...);
+}
+
+template <typename... Parts>
+void Logger::info(const char *fileName, const Parts &... parts) const {
+    reportParts(LogLevel::INFO, { FileTable::NO_FILE, 0 }, fileName, parts...);
+}
+
+template <typename... Parts>
+void Logger::debug(const char *fileName, const Parts &... parts) const {
+    reportParts(LogLevel::DEBUG, { FileTable::NO_FILE, 0 }, fileName, parts...);
+}
+
 
 #endif //OBERON0C_ERRORLOG_H
@@ -0,0 +1,95 @@
+/*
+ * Implementation of the time report used by the Oberon-0 compiler.
+ */
+
+#include <iomanip>
+#include "TimeReport.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#define OBERON0C_HAS_RUSAGE
+#endif
+
+static const char *PHASE_NAMES[] = {
+        "scanner setup", "scanning", "parse", "declarations", "statement sequence", "expression", "symbol table" };
+static const char *COUNTER_NAMES[] = { "tokens", "symbol inserts", "symbol lookups" };
+
+static_assert(sizeof(PHASE_NAMES) / sizeof(PHASE_NAMES[0]) == (size_t) Phase::count, "every phase needs a name");
+static_assert(sizeof(COUNTER_NAMES) / sizeof(COUNTER_NAMES[0]) == (size_t) Counter::count, "every counter needs a name");
+
+bool TimeReport::enabled_ = false;
+TimeReport::PhaseStats TimeReport::phases_[(size_t) Phase::count] = {};
+uint64_t TimeReport::counters_[(size_t) Counter::count] = {};
+
+void TimeReport::setEnabled(const bool enabled) {
+    enabled_ = enabled;
+}
+
+const bool TimeReport::isEnabled() {
+    return enabled_;
+}
+
+const bool TimeReport::isAvailable() {
+#ifdef OBERON0C_TIME_REPORT
+    return true;
+#else
+    return false;
+#endif
+}
+
+void TimeReport::count(const Counter counter, const uint64_t amount) {
+    counters_[(size_t) counter] += amount;
+}
+
+void TimeReport::write(std::ostream &out) {
+    if (!enabled_) {
+        return;
+    }
+    out << "Time report:" << std::endl;
+    out << "  " << std::left << std::setw(24) << "Phase" << std::right << std::setw(12) << "Calls"
+        << std::setw(14) << "Time (ms)" << std::endl;
+    for (size_t i = 0; i < (size_t) Phase::count; i++) {
+        out << "  " << std::left << std::setw(24) << PHASE_NAMES[i] << std::right << std::setw(12)
+            << phases_[i].calls << std::setw(14) << std::fixed << std::setprecision(3)
+            << (double) phases_[i].nanos / 1e6 << std::endl;
+    }
+    out << "  " << std::left << std::setw(24) << "Counter" << std::right << std::setw(12) << "Count" << std::endl;
+    for (size_t i = 0; i < (size_t) Counter::count; i++) {
+        out << "  " << std::left << std::setw(24) << COUNTER_NAMES[i] << std::right << std::setw(12)
+            << counters_[i] << std::endl;
+    }
+#ifdef OBERON0C_HAS_RUSAGE
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        // reported in kilobytes on Linux, but in bytes on macOS
+#ifdef __APPLE__
+        const long kilobytes = usage.ru_maxrss / 1024;
+#else
+        const long kilobytes = usage.ru_maxrss;
+#endif
+        out << "  " << std::left << std::setw(24) << "peak memory (KiB)" << std::right << std::setw(12)
+            << kilobytes << std::endl;
+    }
+#endif
+    out << std::defaultfloat << std::setprecision(6);
+}
+
+PhaseTimer::PhaseTimer(const Phase phase) : phase_(phase), active_(TimeReport::enabled_) {
+    if (active_) {
+        TimeReport::PhaseStats &stats = TimeReport::phases_[(size_t) phase_];
+        stats.calls++;
+        if (stats.depth++ == 0) {
+            stats.start = std::chrono::steady_clock::now();
+        }
+    }
+}
+
+PhaseTimer::~PhaseTimer() {
+    if (active_) {
+        TimeReport::PhaseStats &stats = TimeReport::phases_[(size_t) phase_];
+        if (--stats.depth == 0) {
+            stats.nanos += (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - stats.start).count();
+        }
+    }
+}
@@ -0,0 +1,77 @@
+/*
+ * Header file of the time report used by the Oberon-0 compiler.
+ *
+ * Scoped timers and counters measure the phases of the compiler, which are reported when the compiler is
+ * run with --time-report. The instrumentation is only compiled in if OBERON0C_TIME_REPORT is defined (see
+ * the CMake option of the same name); otherwise TIME_PHASE and COUNT_EVENT expand to nothing.
+ *
+ * Phases nest: the time of a phase includes the time of the phases that it calls, and a phase that is
+ * entered recursively is only timed by its outermost activation, while every activation is counted.
+ */
+
+#ifndef OBERON0C_TIMEREPORT_H
+#define OBERON0C_TIMEREPORT_H
+
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+enum class Phase : unsigned char {
+    scanner_setup, scanning, parse, declarations, statement_sequence, expression, symbol_table, count
+};
+
+enum class Counter : unsigned char { tokens, symbol_inserts, symbol_lookups, count };
+
+class TimeReport {
+
+private:
+    struct PhaseStats {
+        uint64_t nanos;
+        uint64_t calls;
+        unsigned int depth;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    static bool enabled_;
+    static PhaseStats phases_[(size_t) Phase::count];
+    static uint64_t counters_[(size_t) Counter::count];
+
+    friend class PhaseTimer;
+
+public:
+    static void setEnabled(bool enabled);
+    static const bool isEnabled();
+    static const bool isAvailable();
+    static void count(Counter counter, uint64_t amount = 1);
+    static void write(std::ostream &out);
+
+};
+
+/*
+ * Times the enclosing scope as the given phase, if the time report is enabled.
+ */
+class PhaseTimer {
+
+private:
+    Phase phase_;
+    bool active_;
+
+public:
+    explicit PhaseTimer(Phase phase);
+    PhaseTimer(const PhaseTimer &) = delete;
+    PhaseTimer& operator=(const PhaseTimer &) = delete;
+    ~PhaseTimer();
+
+};
+
+#ifdef OBERON0C_TIME_REPORT
+#define TIME_PHASE(phase) PhaseTimer phaseTimer(Phase::phase)
+#define COUNT_EVENT(counter) TimeReport::count(Counter::counter)
+#else
+#define TIME_PHASE(phase)
+#define COUNT_EVENT(counter)
+#endif
+
+
+#endif //OBERON0C_TIMEREPORT_H
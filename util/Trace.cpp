@@ -0,0 +1,170 @@
+/*
+ * Implementation of the trace recorder used by the Oberon-0 compiler.
+ *
+ * The buffer of a thread is created the first time the thread records an event and registers itself in a
+ * global list, which is the only time a lock is taken. When a thread exits, its buffer hands its events over
+ * to the list of retired events, so that the events of worker threads outlive the threads.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <mutex>
+#include <vector>
+#include "Trace.h"
+
+struct TraceEvent {
+    const char *name;
+    std::string detail;
+    unsigned int thread;
+    // in nanoseconds since the start of the program
+    uint64_t start, duration;
+};
+
+struct TraceBuffer {
+    unsigned int thread;
+    std::vector<TraceEvent> events;
+
+    TraceBuffer();
+    ~TraceBuffer();
+};
+
+// initial capacity of the buffer of a thread
+static const size_t TRACE_BUFFER_SIZE = 4096;
+
+static const std::chrono::steady_clock::time_point TRACE_EPOCH = std::chrono::steady_clock::now();
+
+static std::mutex &traceMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+static std::vector<TraceBuffer*> &traceBuffers() {
+    static std::vector<TraceBuffer*> buffers;
+    return buffers;
+}
+
+static std::vector<TraceEvent> &retiredEvents() {
+    static std::vector<TraceEvent> events;
+    return events;
+}
+
+TraceBuffer::TraceBuffer() {
+    std::lock_guard<std::mutex> lock(traceMutex());
+    static unsigned int threads = 0;
+    thread = ++threads;
+    events.reserve(TRACE_BUFFER_SIZE);
+    traceBuffers().push_back(this);
+}
+
+TraceBuffer::~TraceBuffer() {
+    std::lock_guard<std::mutex> lock(traceMutex());
+    auto &buffers = traceBuffers();
+    buffers.erase(std::remove(buffers.begin(), buffers.end(), this), buffers.end());
+    auto &retired = retiredEvents();
+    std::move(events.begin(), events.end(), std::back_inserter(retired));
+}
+
+static TraceBuffer &threadBuffer() {
+    static thread_local TraceBuffer buffer;
+    return buffer;
+}
+
+bool Trace::enabled_ = false;
+
+void Trace::setEnabled(const bool enabled) {
+    enabled_ = enabled;
+}
+
+const bool Trace::isEnabled() {
+    return enabled_;
+}
+
+const bool Trace::isAvailable() {
+#ifdef OBERON0C_TRACE
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint64_t Trace::now() {
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - TRACE_EPOCH).count();
+}
+
+static void writeString(std::ostream &out, const std::string &text) {
+    out << '"';
+    for (const char ch : text) {
+        if (ch == '"' || ch == '\\') {
+            out << '\\' << ch;
+        } else if ((unsigned char) ch >= 0x20) {
+            out << ch;
+        }
+    }
+    out << '"';
+}
+
+static void writeMicros(std::ostream &out, const uint64_t nanos) {
+    out << nanos / 1000 << '.';
+    const uint64_t fraction = nanos % 1000;
+    out << (char) ('0' + fraction / 100) << (char) ('0' + fraction / 10 % 10) << (char) ('0' + fraction % 10);
+}
+
+void Trace::write(std::ostream &out) {
+    if (!enabled_) {
+        return;
+    }
+    std::vector<const TraceEvent*> events;
+    std::lock_guard<std::mutex> lock(traceMutex());
+    for (auto &event : retiredEvents()) {
+        events.push_back(&event);
+    }
+    for (auto buffer : traceBuffers()) {
+        for (auto &event : buffer->events) {
+            events.push_back(&event);
+        }
+    }
+    std::sort(events.begin(), events.end(), [](const TraceEvent *a, const TraceEvent *b) {
+        // an enclosing event comes before the events that start at the same time
+        return a->start < b->start || (a->start == b->start && a->duration > b->duration);
+    });
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (auto event : events) {
+        out << (first ? "\n" : ",\n");
+        first = false;
+        out << "{\"name\":\"" << event->name << "\",\"cat\":\"oberon0c\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+            << event->thread << ",\"ts\":";
+        writeMicros(out, event->start);
+        out << ",\"dur\":";
+        writeMicros(out, event->duration);
+        if (!event->detail.empty()) {
+            out << ",\"args\":{\"name\":";
+            writeString(out, event->detail);
+            out << "}";
+        }
+        out << "}";
+    }
+    out << "\n]}\n";
+    out.flush();
+}
+
+TraceScope::TraceScope(const char *name) : name_(name), start_(0), active_(Trace::enabled_) {
+    if (active_) {
+        start_ = Trace::now();
+    }
+}
+
+TraceScope::~TraceScope() {
+    if (active_) {
+        TraceBuffer &buffer = threadBuffer();
+        buffer.events.push_back({ name_, std::move(detail_), buffer.thread, start_, Trace::now() - start_ });
+    }
+}
+
+void TraceScope::setDetail(const std::string &detail) {
+    if (active_) {
+        detail_ = detail;
+    }
+}
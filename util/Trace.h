@@ -0,0 +1,69 @@
+/*
+ * Header file of the trace recorder used by the Oberon-0 compiler.
+ *
+ * While tracing is enabled, scoped trace events record when a phase of the compiler started and how long it
+ * took, optionally with a detail such as the name of the procedure. Every thread records its events into a
+ * buffer of its own, so recording never takes a lock, and the buffers are only merged when the trace is
+ * written in the Chrome trace event format, which can be loaded into Perfetto or chrome://tracing.
+ *
+ * The recorder is only compiled in if OBERON0C_TRACE is defined (see the CMake option of the same name);
+ * otherwise TRACE_SCOPE and TRACE_DETAIL expand to nothing.
+ */
+
+#ifndef OBERON0C_TRACE_H
+#define OBERON0C_TRACE_H
+
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+class Trace {
+
+private:
+    static bool enabled_;
+
+    static uint64_t now();
+
+    friend class TraceScope;
+
+public:
+    static void setEnabled(bool enabled);
+    static const bool isEnabled();
+    static const bool isAvailable();
+    // writes the events of all threads, which must have finished recording
+    static void write(std::ostream &out);
+
+};
+
+/*
+ * Records the enclosing scope as a trace event with the given name, which has to be a string literal.
+ */
+class TraceScope {
+
+private:
+    const char *name_;
+    std::string detail_;
+    uint64_t start_;
+    bool active_;
+
+public:
+    explicit TraceScope(const char *name);
+    TraceScope(const TraceScope &) = delete;
+    TraceScope& operator=(const TraceScope &) = delete;
+    ~TraceScope();
+
+    void setDetail(const std::string &detail);
+
+};
+
+#ifdef OBERON0C_TRACE
+#define TRACE_SCOPE(name) TraceScope traceScope(name)
+#define TRACE_DETAIL(detail) traceScope.setDetail(detail)
+#else
+#define TRACE_SCOPE(name)
+#define TRACE_DETAIL(detail)
+#endif
+
+
+#endif //OBERON0C_TRACE_H